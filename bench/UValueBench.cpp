@@ -0,0 +1,335 @@
+///-------------------------------------------------------------------------------------------------
+// file:	UValueBench.cpp
+//
+// summary:  Microbenchmarks of the conversion engines and of UValue arithmetic.  Every
+//           benchmark reports its cost per operation as CSV (default) or JSON so the
+//           runs of two versions of the library can be diffed.
+//
+//           uv_bench [--json] [--filter <substring>] [--min-time <ms>]
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "UValue.hpp"
+#include "UValueExpr.hpp"
+
+#ifndef UV_VERSION
+#define UV_VERSION          "unknown"
+#endif
+
+// values converted per timed batch of the engine benchmarks
+#define BENCH_BATCH         256
+
+typedef struct {
+    std::string name;
+    unsigned long long iterations;
+    double ns_per_op;
+} BenchResult;
+
+static std::vector<BenchResult> results;
+static const char * filter = nullptr;
+static double min_time_ns = 1e6;
+
+// keeps the optimizer from discarding a result
+template<typename T>
+static inline void keep(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void * sink;
+    sink = &value;
+#endif
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Times op, doubling the iterations until the run takes at least min_time_ns. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         name - benchmark name
+///         ops_per_call - operations done by one call of op
+///         op - operation to time
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+template<typename Op>
+static void bench(const std::string& name, size_t ops_per_call, Op op)
+{
+    if ( filter && name.find(filter) == std::string::npos ) {
+        return;
+    }
+
+    unsigned long long iterations = 1;
+    double elapsed = 0;
+
+    for(;;)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for(unsigned long long i = 0; i < iterations; i++) {
+            op();
+        }
+        elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        if ( elapsed >= min_time_ns || iterations >= (1ULL << 40) ) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    BenchResult result = { name, iterations*ops_per_call, elapsed/(iterations*ops_per_call) };
+    results.push_back(result);
+}
+
+static void benchEngines(void)
+{
+    double_uv values[BENCH_BATCH];
+
+    for(int unit_class = 0; unit_class < eUnitClassCount; unit_class++)
+    {
+        const UnitClassInfo& info = unit_classes[unit_class];
+        for(int in = 0; in < info.units_len; in++)
+        {
+            for(int out = 0; out < info.units_len; out++)
+            {
+                std::string pair = std::string(info.name) + "/" + info.units[in]
+                                 + "->" + info.units[out];
+
+                bench("engine/" + pair, BENCH_BATCH, [&]() {
+                    for(int i = 0; i < BENCH_BATCH; i++) {
+                        engine_uv value = 1.0 + i;
+                        info.conversion(value, in, out, nullptr, 0);
+                        keep(value);
+                    }
+                });
+
+                bench("plan/" + pair, BENCH_BATCH, [&]() {
+                    for(int i = 0; i < BENCH_BATCH; i++) {
+                        double_uv value = 1.0 + i;
+                        convertWithPlan(unit_class, value, in, out);
+                        keep(value);
+                    }
+                });
+
+                bench("bulk/" + pair, BENCH_BATCH, [&]() {
+                    for(int i = 0; i < BENCH_BATCH; i++) {
+                        values[i] = 1.0 + i;
+                    }
+                    bulkConversion<double_uv>(info)(values, BENCH_BATCH, in, out, nullptr, 0);
+                    keep(values);
+                });
+            }
+        }
+    }
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Polynomial of unlike terms m^a*s^b, starting at the term at offset. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+static UValue polynomial(int terms, int offset)
+{
+    const int meter = unitIndexInClass(eUnitDist, "m");
+    const int second = unitIndexInClass(eUnitTime, "s");
+    UValue poly;
+
+    for(int k = 0; k < terms; k++)
+    {
+        int term = (k + offset) % terms;
+        UValue value = UValue(1.0 + term, eUnitDist, meter, term % 16 + 1)
+                     * UValue(1.0, eUnitTime, second, term / 16 + 1);
+        poly = ( k == 0 ) ? value : poly + value;
+    }
+
+    return poly;
+}
+
+static void benchPolynomial(void)
+{
+    // cost per term stays flat as the terms grow when like terms are found by hash
+    const int sizes[] = { 4, 16, 64, 256 };
+
+    for(int terms : sizes)
+    {
+        const UValue poly = polynomial(terms, 0);
+        // the same terms in another order
+        const UValue shifted = polynomial(terms, terms/2);
+        std::string size = std::to_string(terms);
+
+        bench("poly/add_" + size, terms, [&]() { UValue r = poly + shifted; keep(r); });
+        bench("poly/sub_" + size, terms, [&]() { UValue r = poly - shifted; keep(r); });
+        bench("poly/equal_" + size, terms, [&]() { bool r = (poly == shifted); keep(r); });
+    }
+
+    // whole powers expand by squaring, like terms combined
+    const UValue poly10 = polynomial(10, 0);
+    bench("poly/pow2_10", 1, [&]() { UValue r = poly10.pow(2); keep(r); });
+    bench("poly/pow4_10", 1, [&]() { UValue r = poly10.pow(4); keep(r); });
+}
+
+static void benchUValue(void)
+{
+    const UValue dist(12.5, new DistUnit("km"));
+    const UValue time(0.75, new TimeUnit("h"));
+    const UValue speed = dist/time;
+    // a sum of different units keeps one term per unit
+    const UValue multi = UValue(3.0, new DistUnit("m")) + UValue(2.0, new TimeUnit("s"));
+    const UValue multi2 = UValue(1.0, new DistUnit("ft")) + UValue(4.0, new TimeUnit("min"));
+
+    bench("uvalue/construct_destroy", 1, [&]() {
+        UValue val(1.0, new DistUnit("m"));
+        keep(val);
+    });
+    bench("uvalue/construct_value", 1, [&]() {
+        UValue val(1.0, DistUnit("m"));
+        keep(val);
+    });
+    const int meter = unitIndexInClass(eUnitDist, "m");
+    bench("uvalue/construct_index", 1, [&]() {
+        UValue val(1.0, eUnitDist, meter);
+        keep(val);
+    });
+    bench("uvalue/copy", 1, [&]() {
+        UValue val(speed);
+        keep(val);
+    });
+
+    bench("single/mul", 1, [&]() { UValue r = dist*time; keep(r); });
+    bench("single/div", 1, [&]() { UValue r = dist/time; keep(r); });
+    bench("single/add", 1, [&]() { UValue r = dist + dist; keep(r); });
+    bench("single/sub", 1, [&]() { UValue r = dist - dist; keep(r); });
+    bench("single/mul_scalar", 1, [&]() { UValue r = dist*2.0; keep(r); });
+
+    bench("multi/mul", 1, [&]() { UValue r = multi*multi2; keep(r); });
+    bench("multi/div", 1, [&]() { UValue r = multi/multi2; keep(r); });
+    bench("multi/add", 1, [&]() { UValue r = multi + multi2; keep(r); });
+    bench("multi/sub", 1, [&]() { UValue r = multi - multi2; keep(r); });
+
+    // a*b/(c*c) + d with temporaries and as one expression
+    const UValue accel = dist/(time*time);
+    bench("expr/operators", 1, [&]() { UValue r = dist*speed/(time*time) + accel*dist/time; keep(r); });
+    bench("expr/fused", 1, [&]() { UValue r = uvExpr(dist)*speed/(uvExpr(time)*time) + uvExpr(accel)*dist/time; keep(r); });
+
+    // N + kg*m/s^2 is one term
+    const UValue force(1.0, new ForceUnit("N"));
+    const UValue mass(80.0, new MassUnit("kg"));
+    bench("dim/add", 1, [&]() { UValue r = force + mass*accel; keep(r); });
+    const UValue momentum = mass*accel;
+    bench("dim/reduce", 1, [&]() { UValue r = momentum.reduce(); keep(r); });
+
+    bench("convert/single", 1, [&]() { UValue r = dist["mi"]; keep(r); });
+    bench("convert/compound", 1, [&]() { UValue r = speed["ft"]["min"]; keep(r); });
+    bench("convert/compound_target", 1, [&]() { UValue r = speed["ft/min"]; keep(r); });
+    bench("parse/expression", 1, [&]() { UValue r(9.8, "kg/(m*s^2)"); keep(r); });
+    bench("convert/multi", 1, [&]() { UValue r = multi["ft"]; keep(r); });
+    bench("convert/chain", 1, [&]() { UValue r = dist["cm"]["in"]["ft"]; keep(r); });
+    bench("convert/view_chain", 1, [&]() { UValue r = dist.as("cm")["in"]["ft"]; keep(r); });
+    const UValue energy = UValue(1.5, new PowerUnit("kW"))*time;
+    bench("convert/cross_class", 1, [&]() { UValue r = energy["W-h"]; keep(r); });
+    bench("convert/view_value", 1, [&]() { double_uv v = speed.as("ft")["min"].getValue(); keep(v); });
+
+    bench("print/single", 1, [&]() { std::string s = dist.print(); keep(s); });
+    bench("print/compound", 1, [&]() { std::string s = speed.print(6); keep(s); });
+    bench("print/units", 1, [&]() { std::string s = speed.printUnits(); keep(s); });
+
+    bench("pow/square", 1, [&]() { UValue r = speed.pow(2); keep(r); });
+    bench("pow/root", 1, [&]() { UValue r = speed.pow(0.5); keep(r); });
+    bench("pow/multi", 1, [&]() { UValue r = multi.pow(3); keep(r); });
+}
+
+// unit abbrev. like " (arc second) need quoting in the output
+static std::string csvField(const std::string& field)
+{
+    if ( field.find_first_of(",\"") == std::string::npos ) {
+        return field;
+    }
+
+    std::string quoted = "\"";
+    for(char c : field) {
+        quoted += ( c == '"' ) ? "\"\"" : std::string(1, c);
+    }
+    return quoted + "\"";
+}
+
+static std::string jsonString(const std::string& str)
+{
+    std::string escaped = "\"";
+    for(char c : str) {
+        if ( c == '"' || c == '\\' ) {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+static void printCsv(void)
+{
+    std::cout << "name,iterations,ns_per_op" << std::endl;
+    for(const BenchResult& result : results)
+    {
+        std::cout << csvField(result.name) << "," << result.iterations << "," << result.ns_per_op << std::endl;
+    }
+}
+
+static void printJson(void)
+{
+    std::cout << "{" << std::endl
+              << "  \"version\": \"" << UV_VERSION << "\"," << std::endl
+              << "  \"value_bytes\": " << sizeof(double_uv) << "," << std::endl
+              << "  \"results\": [" << std::endl;
+    for(size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult& result = results[i];
+        std::cout << "    {\"name\": " << jsonString(result.name) << ", \"iterations\": " << result.iterations
+                  << ", \"ns_per_op\": " << result.ns_per_op << "}"
+                  << ( i + 1 < results.size() ? "," : "" ) << std::endl;
+    }
+    std::cout << "  ]" << std::endl << "}" << std::endl;
+}
+
+int main(int argc, const char * argv[])
+{
+    bool json = false;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if ( !strcmp(argv[i], "--json") ) {
+            json = true;
+        }
+        else if ( !strcmp(argv[i], "--csv") ) {
+            json = false;
+        }
+        else if ( !strcmp(argv[i], "--filter") && i + 1 < argc ) {
+            filter = argv[++i];
+        }
+        else if ( !strcmp(argv[i], "--min-time") && i + 1 < argc ) {
+            min_time_ns = atof(argv[++i])*1e6;
+        }
+        else {
+            std::cerr << "usage: " << argv[0] << " [--json|--csv] [--filter <substring>] [--min-time <ms>]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    benchEngines();
+    benchUValue();
+    benchPolynomial();
+
+    std::cout.precision(6);
+    if ( json ) {
+        printJson();
+    }
+    else {
+        printCsv();
+    }
+
+    return 0;
+}
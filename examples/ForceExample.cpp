@@ -9,7 +9,7 @@
 
 #include <stdlib.h>
 #include <iostream>
-#include "UValue.hpp"
+#include "UValueExpr.hpp"
 
 int main(int argc, const char * argv[])
 {
@@ -55,7 +55,7 @@ int main(int argc, const char * argv[])
         std::cin.clear();
     }
     
-    UValue uout = units[0]*units[1];
+    UValue uout = uvExpr(units[0])*units[1];
                             
     std::cout << "Your calculated force is " << uout << "." << std::endl;
                     
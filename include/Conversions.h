@@ -18,14 +18,18 @@
 //  Copyright (c) 2014 by Michael Ryan
 ///-------------------------------------------------------------------------------------------------
 #include <string.h>
+#include <math.h>
+#include <cmath>
+#include <string_view>
+#include <type_traits>
 
 #ifndef __CONVERSIONS_H__
 #define __CONVERSIONS_H__
 
 #ifdef UNITS_CASE_INSENSITIVE
 
-#define STRCMP(a, b)        stricmp(a, b)
-#define STRNCMP(a, b, n)    strnicmp(a, b, n)
+#define STRCMP(a, b)        uv_stricmp(a, b)
+#define STRNCMP(a, b, n)    uv_strnicmp(a, b, n)
 
 #else
 
@@ -34,33 +38,60 @@
 
 #endif
 
+// double_uv is the precision of UValue, UnitGroup and UValueArray.  The library is built
+// for float, double and long double, so UV_USE_LONG_DOUBLE only picks the aliases.
 #ifdef UV_USE_LONG_DOUBLE
 typedef long double double_uv;
 #else
 typedef double double_uv;
 #endif
 
+// the conversion engines, their parameters and conversion plans are long double in every build
+typedef long double engine_uv;
+
+#ifdef WIN32
+
+#define ISNAN(a)            _isnan(a)
+
+#else
+
+#define ISNAN(a)            isnan(a)
+
+#endif
+
+// math of the conversion engines in engine_uv
+#define POW(a,b)            powl(a,b)
+#define LOG10(a)            log10l(a)
+
+// portable ASCII case-insensitive compares
+int uv_stricmp(const char * a, const char * b);
+int uv_strnicmp(const char * a, const char * b, size_t n);
+
 bool foundUnitInUnits(const char * pUnit, const char *const* units, const int units_len);
 
+int unitIndexInUnits(const char * pUnit, const char *const* units, const int units_len);
+int unitIndexInUnits(std::string_view unit, const char *const* units, const int units_len);
+
 /*
  // This function pointer defines the format of the conversion class.
  // For each class a function matching this profile must be created.
  */
 
 typedef bool (*UnitConversion)(
-        double_uv& value_in,
+        engine_uv& value_in,
         int unit_index_in,
         int unit_index_out,
-        const double_uv * params_list,
+        const engine_uv * params_list,
         size_t params_list_len);
 
 extern const char *const scalar[];
+extern const int scalar_len;
 
 // Does nothing except test for isnan
-bool IdentityConversion(double_uv& value_in,
+bool IdentityConversion(engine_uv& value_in,
                             int in,
                             int out,
-                            const double_uv * params_list,
+                            const engine_uv * params_list,
                             size_t params_list_len);
 
 extern const char *const freqs[];
@@ -69,10 +100,10 @@ extern const int freqs_len;
 /*
     Frequency Conversion engine
  */
-bool FreqConversion(double_uv& value_in,
+bool FreqConversion(engine_uv& value_in,
                            int in,
                            int out,
-                           const double_uv * params_list,
+                           const engine_uv * params_list,
                            size_t params_list_len);
 
 extern const char *const times[];
@@ -81,10 +112,10 @@ extern const int times_len;
 /*
  Time Conversion engine
  */
-bool TimeConversion(double_uv& value_in,
+bool TimeConversion(engine_uv& value_in,
                        int in,
                        int out,
-                       const double_uv * params_list,
+                       const engine_uv * params_list,
                        size_t params_list_len);
 
 
@@ -94,10 +125,10 @@ extern const int dists_len;
 /*
  Distance Conversion engine
  */
-bool DistanceConversion(double_uv& value_in,
+bool DistanceConversion(engine_uv& value_in,
                         int in,
                         int out,
-                        const double_uv * params_list,
+                        const engine_uv * params_list,
                         size_t params_list_len);
 
 extern const char *const ampls[] ;
@@ -107,10 +138,10 @@ extern const int ampls_len;
  Power Conversion engine
  */
 //{"dBm", "dBmV", "dBuV", "dBmA", "dBuA", "dB", "V", "W", "A", "mV", "mW", "mA"};
-bool AmplConversion(double_uv& value_in,
+bool AmplConversion(engine_uv& value_in,
                     int in,
                     int out,
-                    const double_uv * params_list,
+                    const engine_uv * params_list,
                     size_t params_list_len);
 
 extern const char *const temps_units[];
@@ -119,10 +150,10 @@ extern const int temps_units_len;
 /*
  Temp Conversion engine
  */
-bool TempConversion(double_uv& value_in,
+bool TempConversion(engine_uv& value_in,
                     int in,
                     int out,
-                    const double_uv * params_list,
+                    const engine_uv * params_list,
                     size_t params_list_len);
 
 extern const char *const currents[];
@@ -132,10 +163,10 @@ extern const int currents_len;
  Current Conversion engine
  */
 
-bool CurrentConversion(double_uv& value_in,
+bool CurrentConversion(engine_uv& value_in,
                        int in,
                        int out,
-                       const double_uv * params_list,
+                       const engine_uv * params_list,
                        size_t params_list_len);
 
 extern const char *const volumes[];
@@ -145,10 +176,10 @@ extern const int volumes_len;
  Volume Conversion engine
  */
 
-bool VolumeConversion(double_uv& value_in,
+bool VolumeConversion(engine_uv& value_in,
                       int in,
                       int out,
-                      const double_uv * params_list,
+                      const engine_uv * params_list,
                       size_t params_list_len);
 
 extern const char *const masses[];
@@ -158,10 +189,10 @@ extern const int masses_len;
  Mass Conversion engine
  */
 
-bool MassConversion(double_uv& value_in,
+bool MassConversion(engine_uv& value_in,
                     int in,
                     int out,
-                    const double_uv * params_list,
+                    const engine_uv * params_list,
                     size_t params_list_len);
 
 extern const char *const forces[];
@@ -171,10 +202,10 @@ extern const int forces_len;
  Force Conversion engine
  */
 
-bool ForceConversion(double_uv& value_in,
+bool ForceConversion(engine_uv& value_in,
                      int in,
                      int out,
-                     const double_uv * params_list,
+                     const engine_uv * params_list,
                      size_t params_list_len);
 
 extern const char *const pressures[];
@@ -184,10 +215,10 @@ extern const int pressures_len;
  Pressure Conversion engine
  */
 
-bool PressureConversion(double_uv& value_in,
+bool PressureConversion(engine_uv& value_in,
                         int in,
                         int out,
-                        const double_uv * params_list,
+                        const engine_uv * params_list,
                         size_t params_list_len);
 
 extern const char *const energies[];
@@ -197,10 +228,10 @@ extern const int energies_len;
  Energy Conversion engine
  */
 
-bool EnergyConversion(double_uv& value_in,
+bool EnergyConversion(engine_uv& value_in,
                       int in,
                       int out,
-                      const double_uv * params_list,
+                      const engine_uv * params_list,
                       size_t params_list_len);
 
 extern const char *const powers[];
@@ -210,10 +241,10 @@ extern const int powers_len;
  Power Conversion engine
  */
 
-bool PowerConversion(double_uv& value_in,
+bool PowerConversion(engine_uv& value_in,
                      int in,
                      int out,
-                     const double_uv * params_list,
+                     const engine_uv * params_list,
                      size_t params_list_len);
 
 extern const char *const angles[];
@@ -223,10 +254,10 @@ extern const int angles_len;
  Angle Conversion engine
  */
 
-bool AngleConversion(double_uv& value_in,
+bool AngleConversion(engine_uv& value_in,
                      int in,
                      int out,
-                     const double_uv * params_list,
+                     const engine_uv * params_list,
                      size_t params_list_len);
 
 extern const char *const areas[];
@@ -236,11 +267,468 @@ extern const int areas_len;
  Area Conversion engine
  */
 
-bool AreaConversion(double_uv& value_in,
+bool AreaConversion(engine_uv& value_in,
                      int in,
                      int out,
-                     const double_uv * params_list,
+                     const engine_uv * params_list,
                      size_t params_list_len);
 
+/*
+ Conversion plans - a (unit class, unit in, unit out, params) conversion resolved once
+ into the single operation that applies it
+ */
+typedef enum {
+    ePlanInvalid = 0,       // units can not be converted
+    ePlanIdentity,          // value
+    ePlanScale,             // value*scale
+    ePlanAffine,            // value*scale + offset
+    ePlanToLog,             // scale*log10(value) + offset
+    ePlanFromLog,           // 10^(value*scale + offset)
+    ePlanPower              // scale*value^power (linear to linear through the log domain)
+} ConversionPlanKind;
+
+typedef struct {
+    ConversionPlanKind kind;
+    engine_uv scale;
+    engine_uv offset;
+    engine_uv power;
+} ConversionPlan;
+
+/*
+ Applies a conversion plan to value_in.  Returns false if the plan is invalid or
+ the result is NaN, as the conversion engines do.  The plan is applied in the
+ precision of T (float, double or long double).
+ */
+template<typename T>
+inline bool applyConversionPlan(const ConversionPlan& plan, T& value_in)
+{
+    switch(plan.kind) {
+        case ePlanIdentity:
+            break;
+        case ePlanScale:
+            value_in = value_in*(T)plan.scale;
+            break;
+        case ePlanAffine:
+            value_in = value_in*(T)plan.scale + (T)plan.offset;
+            break;
+        case ePlanToLog:
+            value_in = (T)plan.scale*std::log10(value_in) + (T)plan.offset;
+            break;
+        case ePlanFromLog:
+            value_in = std::pow((T)10, value_in*(T)plan.scale + (T)plan.offset);
+            break;
+        case ePlanPower:
+            value_in = ( value_in < 0 ) ? (T)NAN : (T)plan.scale*std::pow(value_in, (T)plan.power);
+            break;
+        default:
+            return false;
+    }
+
+    return (!ISNAN(value_in));
+}
+
+/*
+ // This function pointer defines the format of the bulk conversion engines for values of T
+ // (float, double or long double).
+ // values[0..count) are converted in place and the number of NaN results is returned.
+ */
+template<typename T>
+using UnitConversionBulk = size_t (*)(
+        T * values,
+        size_t count,
+        int unit_index_in,
+        int unit_index_out,
+        const engine_uv * params_list,
+        size_t params_list_len);
+
+/*
+ // This function pointer defines the format of the conversion planner of a class.
+ // It resolves the conversion from unit_index_in to unit_index_out into plan.
+ */
+typedef bool (*UnitConversionPlanner)(
+        ConversionPlan& plan,
+        UnitConversion conversion,
+        int unit_index_in,
+        int unit_index_out,
+        const engine_uv * params_list,
+        size_t params_list_len);
+
+// Plans nothing but the NaN test
+bool IdentityConversionPlan(ConversionPlan& plan, UnitConversion conversion, int in, int out,
+                            const engine_uv * params_list, size_t params_list_len);
+
+// Plans a linear engine by evaluating its factor once
+bool ScaleConversionPlan(ConversionPlan& plan, UnitConversion conversion, int in, int out,
+                         const engine_uv * params_list, size_t params_list_len);
+
+// Plans power ratio conversions in or out of the log domain
+bool AmplConversionPlan(ConversionPlan& plan, UnitConversion conversion, int in, int out,
+                        const engine_uv * params_list, size_t params_list_len);
+
+// Plans temperature conversions as scale and offset
+bool TempConversionPlan(ConversionPlan& plan, UnitConversion conversion, int in, int out,
+                        const engine_uv * params_list, size_t params_list_len);
+
+/*
+ Unit classes - one per conversion engine.  The identifiers index unit_classes[]
+ and the per-class slots of a UnitGroup.
+ */
+typedef enum {
+    eUnitScalar = 0,
+    eUnitFrequency,
+    eUnitAmpl,
+    eUnitTime,
+    eUnitDist,
+    eUnitTemp,
+    eUnitCurrent,
+    eUnitVolume,
+    eUnitMass,
+    eUnitForce,
+    eUnitPressure,
+    eUnitEnergy,
+    eUnitPower,
+    eUnitAngle,
+    eUnitArea,
+    eUnitClassCount
+} UnitClassId;
+
+/*
+ How the engine of a unit class maps values.  A unit raised to an exponent converts by
+ factor^exponent in a linear class, while affine and log classes only convert units
+ of exponent 1.
+ */
+typedef enum {
+    eEngineLinear = 0,      // value*factor
+    eEngineAffine,          // value*scale + offset (i.e. temperatures)
+    eEngineLog              // in or out of the log domain (i.e. power ratios)
+} UnitEngineKind;
+
+/*
+ SI base dimensions.  The units of a unit class are products of powers of these
+ (i.e. force is M L T^-2), so terms in units of different classes can be like terms.
+ */
+typedef enum {
+    eDimMass = 0,           // M
+    eDimLength,             // L
+    eDimTime,               // T
+    eDimCurrent,            // I
+    eDimTemperature,        // Θ
+    eDimCount
+} DimensionId;
+
+// exponents of the base dimensions packed DIMENSION_KEY_BITS to each, M lowest
+#define DIMENSION_KEY_BITS      12
+#define DIMENSION_KEY(m, l, t, i, o)                                                            \
+    ((long long)(m) + (long long)(l)*(1LL << DIMENSION_KEY_BITS)                                \
+     + (long long)(t)*(1LL << 2*DIMENSION_KEY_BITS) + (long long)(i)*(1LL << 3*DIMENSION_KEY_BITS) \
+     + (long long)(o)*(1LL << 4*DIMENSION_KEY_BITS))
+// largest exponent of a unit packed in a dimension key of a term (whole numbers only) - keys of
+// two terms of eUnitClassCount units then differ by less than half the range of a base dimension
+#define DIMENSION_KEY_MAX_EXPONENT  16
+// dimension of a unit class in its registry entry
+#define UNIT_DIMENSION(m, l, t, i, o)   { m, l, t, i, o }, DIMENSION_KEY(m, l, t, i, o)
+
+/*
+ Registry entry of a unit class - everything that distinguishes one AtomicUnit
+ subclass from another.
+ */
+typedef struct {
+    const char *const* units;
+    int units_len;
+    UnitConversion conversion;
+    UnitConversionPlanner planner;
+    UnitConversionBulk<float> bulk_conversion_float;
+    UnitConversionBulk<double> bulk_conversion_double;
+    UnitConversionBulk<long double> bulk_conversion_long_double;
+    const char * name;              // display name of the class, i.e. "Dist"
+    int default_unit;               // index of the default unit in units
+    const engine_uv * params;       // default parameters of the engine (nullptr if none)
+    int params_len;
+    UnitEngineKind engine_kind;
+    signed char dimension[eDimCount];   // exponents of the SI base dimensions
+    long long dimension_key;            // dimension packed by DIMENSION_KEY
+    int si_unit;                        // index of the coherent SI unit in units (i.e. "kg")
+} UnitClassInfo;
+
+extern const UnitClassInfo unit_classes[eUnitClassCount];
+
+/*
+ Bulk conversion engine of a unit class for values of T (float, double or long double)
+ */
+template<typename T>
+inline UnitConversionBulk<T> bulkConversion(const UnitClassInfo& info)
+{
+    if constexpr ( std::is_same<T, float>::value ) {
+        return info.bulk_conversion_float;
+    }
+    else if constexpr ( std::is_same<T, double>::value ) {
+        return info.bulk_conversion_double;
+    }
+    else {
+        return info.bulk_conversion_long_double;
+    }
+}
+
+/*
+ Returns the UnitClassId that owns the units table, or -1 if none does
+ */
+int unitClassOfUnits(const char *const* units);
+
+/*
+ Bit mask (1 << UnitClassId) of the unit classes matched by dimension - the linear classes
+ with a dimension.  Scalars, angles, power ratios and temperatures only match themselves.
+ */
+unsigned int dimensionalClassMask(void);
+
+/*
+ Factor from unit index of unit_class raised to exponent to the SI unit of the class raised
+ to exponent.  NaN if the class is not matched by dimension.
+ */
+engine_uv dimensionFactor(int unit_class, int unit_index, double exponent);
+
+/*
+ Derived unit index - the unit class matched by dimension whose units have the dimensions
+ packed in dimension_key (see DIMENSION_KEY), i.e. eUnitForce for kg*m/s^2.  -1 if there is none.
+ */
+int unitClassOfDimension(long long dimension_key);
+
+/*
+ Route across unit classes - units of the dimensions packed in a dimension key as a unit of
+ unit_class raised to exponent, times the rest of the dimensions as the SI unit of rest_class
+ raised to rest_exponent (i.e. kW*h is W-h, W-h is W*s, m^2 is sq m).  rest_class is -1 when
+ unit_class covers all of the dimensions.
+ */
+typedef struct {
+    int unit_class;
+    double exponent;
+    int rest_class;
+    double rest_exponent;
+} CrossClassRoute;
+
+// largest power of a unit class tried for a route, i.e. m^3 for a volume
+#define CROSS_CLASS_MAX_EXPONENT    3
+
+/*
+ Resolves the route from units of the dimensions in dimension_key to unit_class.  Each pair
+ is resolved once and cached.  false if unit_class is not matched by dimension or there is
+ no route.
+ */
+bool crossClassRoute(long long dimension_key, int unit_class, CrossClassRoute& route);
+
+/*
+ Errors of a unit target - the units a value is converted to, i.e. "km/h"
+ */
+typedef enum {
+    eTargetOk = 0,
+    eTargetEmpty,           // no units
+    eTargetSyntax,          // an operator without a unit on both sides or a bad exponent (i.e. "km//h")
+    eTargetUnknownUnit,     // a unit abbrev. of no unit class
+    eTargetTooManyUnits,    // more than UNIT_TARGET_MAX_FACTORS units
+    eTargetRepeatedClass,   // two units of one class (i.e. "m*ft")
+    eTargetMismatch         // the units do not fit the value, or its units could not be converted
+} UnitTargetError;
+
+#define UNIT_TARGET_MAX_FACTORS     8
+
+/*
+ Unit of a unit target raised to exponent.  An abbrev. can name a unit of more than one class
+ (i.e. "min" is a time and an angle), so its index is held for each of the classes.
+ */
+typedef struct {
+    unsigned int classes;           // bit mask (1 << UnitClassId) of the classes with the abbrev.
+    short index[eUnitClassCount];   // index of the unit in each of classes
+    double exponent;
+} UnitTargetFactor;
+
+typedef struct {
+    int factors_len;
+    UnitTargetFactor factors[UNIT_TARGET_MAX_FACTORS];
+} UnitTarget;
+
+/*
+ Parses a unit target - units joined by '*' and '/', each unit or parenthesized group raised
+ to an optional ^exponent (i.e. "km/h", "kg/(m*s^2)", "(sq ft)^2").  Each unit is the longest
+ abbrev. of a unit class before an operator, so abbrevs. with spaces or operators in them
+ (i.e. "1/64 in", "Imp fl oz", the Force unit "kg*m/s^2") are taken whole.
+ */
+UnitTargetError parseUnitTarget(std::string_view units, UnitTarget& target);
+
+// number of strings held by the unit target cache - strings beyond it are parsed each time
+#define UNIT_TARGET_CACHE_MAX       4096
+
+/*
+ parseUnitTarget through a thread safe cache keyed on the exact string, so a string seen before
+ costs one hash lookup.  target points to the cached result, which stays valid for the
+ program's life, or to scratch when the cache is full.
+ */
+UnitTargetError cachedUnitTarget(std::string_view units, const UnitTarget *& target, UnitTarget& scratch);
+
+/*
+ Perfect hash lookup of a unit abbrev. in the units table of a unit class.
+ Returns the index of the unit or -1 if it is not in the table.
+ unitIndexInClass is case insensitive when UNITS_CASE_INSENSITIVE is defined.
+ */
+int unitIndexInClass(int unit_class, std::string_view unit);
+int unitIndexInClassExact(int unit_class, std::string_view unit);
+int unitIndexInClassNoCase(int unit_class, std::string_view unit);
+
+/*
+ Resolves the conversion of a unit class from unit index in to unit index out into plan.
+ Returns false (and an ePlanInvalid plan) if the indexes are not units of the class.
+ */
+bool makeConversionPlan(ConversionPlan& plan, int unit_class, int in, int out,
+                        const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+
+/*
+ Resolves the conversion of a unit raised to exponent from unit index in to unit index out.
+ Linear classes scale by the cached factor^exponent.  Affine and log classes give an
+ ePlanInvalid plan (and false) for any exponent but 1, unless in == out.
+ */
+bool makeExponentPlan(ConversionPlan& plan, int unit_class, int in, int out, double exponent,
+                      const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+
+/*
+ Cached plan for the conversion with default parameters.  The plans of a class are
+ resolved once on first use and the reference stays valid for the program's life.
+ */
+const ConversionPlan& conversionPlan(int unit_class, int in, int out);
+
+/*
+ Hot path counters - compiled in with UV_ENABLE_COUNTERS, otherwise the hooks are
+ empty.  The counters of a thread are read and reset through UValueCounters.h.
+ */
+typedef enum {
+    eAllocUnitParams = 0,   // parameters list of an AtomicUnit
+    eAllocTerm,             // term of a UValue
+    eAllocArray,            // value buffer of a UValueArray
+    eAllocSiteCount
+} AllocationSite;
+
+#ifdef UV_ENABLE_COUNTERS
+
+void countConversion(int unit_class, int in, int out, size_t values, size_t nans);
+void countClone(int unit_class);
+void countAllocation(AllocationSite site, int unit_class);
+void countVectorValues(size_t values);
+
+#define UV_COUNT_CONVERSION(unit_class, in, out, values, nans)  countConversion(unit_class, in, out, values, nans)
+#define UV_COUNT_CLONE(unit_class)                              countClone(unit_class)
+#define UV_COUNT_ALLOCATION(site, unit_class)                   countAllocation(site, unit_class)
+#define UV_COUNT_VECTOR(values)                                 countVectorValues(values)
+
+#else
+
+#define UV_COUNT_CONVERSION(unit_class, in, out, values, nans)  ((void)0)
+#define UV_COUNT_CLONE(unit_class)                              ((void)0)
+#define UV_COUNT_ALLOCATION(site, unit_class)                   ((void)0)
+#define UV_COUNT_VECTOR(values)                                 ((void)0)
+
+#endif
+
+/*
+ Converts value_in with the cached plan, or a plan resolved for params_list if given
+ */
+template<typename T>
+inline bool convertWithPlan(int unit_class, T& value_in, int in, int out,
+                            const engine_uv * params_list = nullptr, size_t params_list_len = 0)
+{
+    bool ret = false;
+
+    if ( params_list && params_list_len > 0 ) {
+        ConversionPlan plan;
+        makeConversionPlan(plan, unit_class, in, out, params_list, params_list_len);
+        ret = applyConversionPlan(plan, value_in);
+    }
+    else {
+        ret = applyConversionPlan(conversionPlan(unit_class, in, out), value_in);
+    }
+    UV_COUNT_CONVERSION(unit_class, in, out, 1, ret ? 0 : 1);
+
+    return ret;
+}
+
+/*
+ Converts value_in of a unit raised to exponent, see makeExponentPlan
+ */
+template<typename T>
+inline bool convertWithExponentPlan(int unit_class, T& value_in, int in, int out, double exponent,
+                                    const engine_uv * params_list = nullptr, size_t params_list_len = 0)
+{
+    if ( exponent == 1 ) {
+        return convertWithPlan(unit_class, value_in, in, out, params_list, params_list_len);
+    }
+
+    ConversionPlan plan;
+    makeExponentPlan(plan, unit_class, in, out, exponent, params_list, params_list_len);
+    bool ret = applyConversionPlan(plan, value_in);
+    UV_COUNT_CONVERSION(unit_class, in, out, 1, ret ? 0 : 1);
+
+    return ret;
+}
+
+/*
+ // Bulk conversion - converts count values in place with one plan.  The linear and
+ // affine plans run SSE2/AVX2 kernels for buffers of double and float.
+ // Returns the number of NaN results, or count (values untouched) if the plan is invalid.
+ // Built for T of float, double and long double.
+ */
+template<typename T>
+size_t applyConversionPlanBulk(const ConversionPlan& plan, T * values, size_t count);
+
+/*
+ Bulk conversion with the cached plan, or a plan resolved for params_list if given
+ */
+template<typename T>
+size_t convertBulk(int unit_class, T * values, size_t count, int in, int out,
+                   const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+
+/*
+ Bulk versions of the conversion engines, built for T of float, double and long double
+ */
+template<typename T>
+size_t IdentityConversionBulk(T * values, size_t count, int in, int out,
+                              const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t FreqConversionBulk(T * values, size_t count, int in, int out,
+                          const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t AmplConversionBulk(T * values, size_t count, int in, int out,
+                          const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t TimeConversionBulk(T * values, size_t count, int in, int out,
+                          const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t DistanceConversionBulk(T * values, size_t count, int in, int out,
+                              const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t TempConversionBulk(T * values, size_t count, int in, int out,
+                          const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t CurrentConversionBulk(T * values, size_t count, int in, int out,
+                             const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t VolumeConversionBulk(T * values, size_t count, int in, int out,
+                            const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t MassConversionBulk(T * values, size_t count, int in, int out,
+                          const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t ForceConversionBulk(T * values, size_t count, int in, int out,
+                           const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t PressureConversionBulk(T * values, size_t count, int in, int out,
+                              const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t EnergyConversionBulk(T * values, size_t count, int in, int out,
+                            const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t PowerConversionBulk(T * values, size_t count, int in, int out,
+                           const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t AngleConversionBulk(T * values, size_t count, int in, int out,
+                           const engine_uv * params_list = nullptr, size_t params_list_len = 0);
+template<typename T>
+size_t AreaConversionBulk(T * values, size_t count, int in, int out,
+                          const engine_uv * params_list = nullptr, size_t params_list_len = 0);
 
 #endif // __CONVERSIONS_H__
\ No newline at end of file
@@ -19,11 +19,17 @@
 ///-------------------------------------------------------------------------------------------------
 
 #pragma once
+#include <cassert>
 #include <iostream>
 #include <string.h>
 #include <sstream>
 #include <map>
 #include <list>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <math.h>
 #include "Conversions.h"
 
@@ -31,8 +37,10 @@
 #define __UVALUE_H__
 
 
-#define MAP_ATOMIC_UNITS	std::map<std::string, AtomicUnit*>
-#define LIST_UNIT_GROUP		std::list<UnitGroup>
+#define LIST_UNIT_GROUP		UValue::UnitGroupList
+
+// maximum number of conversion parameters held inline for a unit (i.e. impedance)
+#define UNIT_SLOT_PARAMS                            1
 
 
 // ***********************  DEFINES for UValues  ***********************
@@ -40,9 +48,24 @@
 #define UVALUE_COMPARISON_NOT_DEFINED               0x00001
 #define UVALUE_OPER_NOT_POSSIBLE                    0x00002
 
-class UnitGroup;
+template<typename T> class BasicUnitGroup;
+template<typename T> class BasicUValue;
+template<typename T> class BasicUValueView;
+template<typename T, typename E> class UExpr;
 class AtomicUnit;
 
+// UnitGroup and UValue hold double_uv values - the other precisions are BasicUValue<float> etc.
+typedef BasicUnitGroup<double_uv> UnitGroup;
+typedef BasicUValue<double_uv> UValue;
+typedef BasicUValueView<double_uv> UValueView;
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Reducer - rule of the unit a Unit Group is reduced to (see BasicUnitGroup::reduce). </summary>
+///
+/// <remarks>	Michael Ryan, 4/25/2016.
+///             The rule gives the unit of a dimension, by default the SI unit of the unit class
+///             with that dimension (N, J, W, Pa, sq m ...).  Derived rules may choose others. </remarks>
+///-------------------------------------------------------------------------------------------------
 class Reducer
 {
 protected:
@@ -52,6 +75,11 @@ public:
 	virtual ~Reducer();
 
 	UnitGroup &reduce();
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Reducer unit of the dimensions packed in dimension_key (see DIMENSION_KEY).
+	///             False if the group is left as it is. </summary>
+	///-------------------------------------------------------------------------------------------------
+	virtual bool derivedUnit(long long dimension_key, int& unit_class, int& unit_index) const;
 };
 
 class AtomicFormatter
@@ -71,7 +99,7 @@ private:
 	const char reduce_chain[3][4] = {"deg", "min", "sec"};
 	UnitGroup &parentGroup;
 public:
-	DegMinSec(UnitGroup &ug): parentGroup(ug) {this->parent(ug.getUnits()[AngleUnit().getName()]);}
+	DegMinSec(UnitGroup &ug): parentGroup(ug) {this->parent(ug.getUnits()[eUnitAngle]);}
 	~DegMinSec() {}
 
 	std::ostream &print(std::ostream &out) {
@@ -96,9 +124,30 @@ public:
 };
 */
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Atomic Unit Class. </summary>
+/// <summary>	Unit Record - a unit as plain data.  Everything else about the unit is looked
+///             up in unit_classes[unit_class]. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         unit_class - UnitClassId of the unit
+///         index - index of the unit in the class's units
+///         exponent - exponent of the unit
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+typedef struct {
+    short unit_class;
+    short index;
+    double exponent;
+} UnitRecord;
+
+static_assert(std::is_trivially_copyable<UnitRecord>::value, "UnitRecord must stay plain data");
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit Class. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             The unit classes are entries of unit_classes, so AtomicUnit has no virtual
+///             methods apart from its destructor and the subclasses are only constructors. </remarks>
 ///-------------------------------------------------------------------------------------------------
 
 class AtomicUnit
@@ -108,16 +157,16 @@ private:
 	size_t len_units;
 	int cur_index;
     
-	double_uv * params_list;
+	engine_uv * params_list;
 	size_t params_list_len;
+	// where the unit and its parameters list live (nullptr for new/delete)
+	std::pmr::memory_resource * resource;
     
     bool reduce;
 
 	UnitConversion conversion;
 
-    size_t typeid_hash;
-protected:
-    
+    int unit_class;
 
 public:
     static const char exponentChar = '^';
@@ -127,8 +176,8 @@ public:
     const char * def_unit;
 	const char * cur_unit;
     
-    friend class UnitGroup;
-    friend class UValue;
+    template<typename T> friend class BasicUnitGroup;
+    template<typename T> friend class BasicUValue;
     
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Atomic Unit Constructor. </summary>
@@ -162,7 +211,25 @@ public:
                         int len, UnitConversion unit_conv,
                         const char * current_unit,
                         const char * default_unit = nullptr,
-                        double_uv * params = nullptr, int params_len = 0);
+                        engine_uv * params = nullptr, int params_len = 0);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Atomic Unit Constructor for a registered unit class. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <parameters>
+    ///         unit_class_in - unit class (units, UnitConversion and the default unit are
+    ///                         taken from unit_classes)
+    ///         current_unit - starting unit (abbrev. from the class's units, nullptr for the default)
+    /// </parameters>
+    ///-------------------------------------------------------------------------------------------------
+	explicit AtomicUnit(UnitClassId unit_class_in, const char * current_unit = nullptr);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Atomic Unit Constructor from a Unit Record (a scalar if the record's
+    ///             unit_class is not a UnitClassId). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	explicit AtomicUnit(const UnitRecord& record);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Atomic Unit Copy Constructor. </summary>
     ///
@@ -170,30 +237,69 @@ public:
     ///-------------------------------------------------------------------------------------------------
 	AtomicUnit(const AtomicUnit& au);
     ///-------------------------------------------------------------------------------------------------
-    /// <summary>	Atomic Unit Destructor. </summary>
+    /// <summary>	Atomic Unit Copy Constructor allocating from a memory resource. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	AtomicUnit(const AtomicUnit& au, std::pmr::memory_resource * resource_in);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Atomic Unit Move Constructor (takes over the parameters list). </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	AtomicUnit(AtomicUnit&& au) noexcept;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Atomic Unit Destructor. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012.
+    ///             Virtual only so a subclass made with new (i.e. new DistUnit("m")) can be
+    ///             deleted through an AtomicUnit pointer. </remarks>
     ///-------------------------------------------------------------------------------------------------
 	virtual ~AtomicUnit(void);
     ///-------------------------------------------------------------------------------------------------
-    /// <summary>	Atomic Unit Create. </summary>
+    /// <summary>	Atomic Unit Create - new unit of the same class in its default unit. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	virtual AtomicUnit * create(void) = 0;
+	AtomicUnit * create(void) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Atomic Unit Clone. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	virtual AtomicUnit * clone(void) const = 0;
+	AtomicUnit * clone(void) const;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Atomic Unit Clone into a memory resource.  Release the clone with destroy(). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	AtomicUnit * clone(std::pmr::memory_resource * resource) const;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Atomic Unit Destroy - deletes the unit or returns it to its memory resource. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	void destroy(void);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Atomic Unit memory resource (nullptr if allocated with new). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	std::pmr::memory_resource * getResource(void) const { return resource; }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Atomic Unit as a Unit Record (unit_class is -1 for units tables not in
+    ///             unit_classes). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	UnitRecord record(void) const;
 
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Atomic Unit Convert. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	bool convert (double_uv& value_in, int unit_index_out);
+	bool convert (engine_uv& value_in, int unit_index_out);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Atomic Unit Test for Identical Units. </summary>
     ///
@@ -205,25 +311,26 @@ public:
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	void setParams(double_uv * params, size_t params_len);
+	void setParams(engine_uv * params, size_t params_len);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Atomic Unit Get Parameters List. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-    const double_uv * getParams(void);
+    const engine_uv * getParams(void);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Atomic Unit Set Parameter in Parameters List. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	void setParam(double_uv param, size_t index);
+	void setParam(engine_uv param, size_t index);
     ///-------------------------------------------------------------------------------------------------
-    /// <summary>	Atomic Unit Get Parameter in Parameters List. </summary>
+    /// <summary>	Atomic Unit Get Parameter in Parameters List (the unit class's default
+    ///             if the unit has not set it). </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-    double_uv getParam(size_t index);
+    engine_uv getParam(size_t index);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	[] Operator by index. </summary>
     ///
@@ -231,11 +338,13 @@ public:
     ///-------------------------------------------------------------------------------------------------
 	const char * operator[] (const int index) const;
     ///-------------------------------------------------------------------------------------------------
-    /// <summary>	[] Operator by Abbrev. </summary>
+    /// <summary>	[] Operator by Abbrev. - index of the unit, or -1 if it is not one of the units. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
 	int operator[] (const char * pszUnits) const;
+	int operator[] (std::string_view unit) const;
+	int indexOrDefault(const char * pszUnits, int index_missing) const;
 
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Atomic Unit Comparision. </summary>
@@ -257,14 +366,22 @@ public:
     ///-------------------------------------------------------------------------------------------------
     bool sameUnitType(const AtomicUnit * unitToCompare) const;
     ///-------------------------------------------------------------------------------------------------
-    /// <summary>	Atomic Unit get name. </summary>
+    /// <summary>	Atomic Unit get unit class (-1 for units tables not in unit_classes). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 6/11/20123 </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    int getUnitClass(void) const { return unit_class; }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Atomic Unit get name (for display only). </summary>
     ///
     /// <remarks>	Michael Ryan, 6/11/20123 </remarks>
     ///-------------------------------------------------------------------------------------------------
-    virtual const char * getName(void) const ;
+    const char * getName(void) const ;
 
 private:
     AtomicUnit& operator=(const AtomicUnit &unit_in);
+    engine_uv * allocParams(size_t params_len);
+    void freeParams(void);
 } ; // end class AtomicUnit
 
 ///-------------------------------------------------------------------------------------------------
@@ -279,60 +396,353 @@ class ScalarUnit
 	: public AtomicUnit
 {
 public:
-	ScalarUnit(void);
-    ScalarUnit * create(void);
-	ScalarUnit * clone(void) const;
+    static const UnitClassId class_id = eUnitScalar;
+
+	ScalarUnit(void) : AtomicUnit(class_id) {}
 };
 
 
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Unit Group. </summary>
+/// <summary>	Unit Slot - the state of one unit class within a Unit Group. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         cur_index - index of the current unit in the class's unit table
+///         params_len - number of parameters held in params
+///         exponent - exponent of the unit
+///         params - parameters not handled in UnitConversion (i.e. impedance)
+/// </parameters>
 ///-------------------------------------------------------------------------------------------------
+struct UnitSlot
+{
+    short cur_index;
+    unsigned char params_len;
+    double exponent;
+    engine_uv params[UNIT_SLOT_PARAMS];
+};
 
-class UnitGroup {
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Table - fixed size table of Unit Slots indexed by UnitClassId. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+class UnitTable
+{
+private:
+    UnitSlot _slots[eUnitClassCount];
+    unsigned int _present;
+
+    static unsigned int hashExponent(unsigned int h, double exponent) {
+        exponent = ( exponent == 0 ) ? 0.0 : exponent;
+        unsigned long long bits;
+        memcpy(&bits, &exponent, sizeof(bits));
+        h ^= (unsigned int)(bits ^ (bits >> 32));
+        return h*16777619u;
+    }
+    void copySlots(const UnitTable& table) {
+        for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class) {
+            if ( contains(unit_class) ) {
+                _slots[unit_class] = table._slots[unit_class];
+            }
+        }
+    }
+public:
+    UnitTable(void) : _present(0) {}
+    // only the slots held are copied
+    UnitTable(const UnitTable& table) : _present(table._present) { copySlots(table); }
+    UnitTable& operator=(const UnitTable& table) {
+        if ( this != &table ) {
+            _present = table._present;
+            copySlots(table);
+        }
+        return *this;
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table has a unit of unit_class. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    bool contains(int unit_class) const { return (_present & (1u << unit_class)) != 0; }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table number of units. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    size_t size(void) const {
+        size_t n = 0;
+        for(unsigned int present = _present; present; present &= present - 1) {
+            ++n;
+        }
+        return n;
+    }
+    bool empty(void) const { return _present == 0; }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table bit mask of the unit classes held. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    unsigned int mask(void) const { return _present; }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table slot of unit_class (only valid if contains(unit_class)). </summary>
+    ///-------------------------------------------------------------------------------------------------
+    UnitSlot& operator[](int unit_class) { return _slots[unit_class]; }
+    const UnitSlot& operator[](int unit_class) const { return _slots[unit_class]; }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table add or replace the unit of unit_class.  At most UNIT_SLOT_PARAMS
+    ///             parameters are held - callers reject units with more (see setUnit). </summary>
+    ///-------------------------------------------------------------------------------------------------
+    UnitSlot& insert(int unit_class, int cur_index, double exponent,
+                     const engine_uv * params = nullptr, size_t params_len = 0) {
+        assert(params_len <= UNIT_SLOT_PARAMS);
+        UnitSlot& slot = _slots[unit_class];
+        slot.cur_index = (short)cur_index;
+        slot.exponent = exponent;
+        slot.params_len = (unsigned char)((params_len < UNIT_SLOT_PARAMS) ? params_len : UNIT_SLOT_PARAMS);
+        for(size_t i = 0; i < slot.params_len; ++i) {
+            slot.params[i] = params[i];
+        }
+        _present |= (1u << unit_class);
+        return slot;
+    }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table of the units of a parsed unit target, one unit per class. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012.
+    ///             An abbrev. of more than one class (i.e. "min") is a unit of each of the
+    ///             classes in held that have it, or else of the first class matched by dimension
+    ///             (see dimensionalClassMask), or else of the first class.  Units of a class
+    ///             whose exponents sum to 0 are dropped. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    UnitTargetError fromTarget(const UnitTarget& target, unsigned int held = 0);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table of a unit expression, i.e. "kg*m/s^2" or "lbf/(sq in)", parsed
+    ///             through the cache of cachedUnitTarget. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    UnitTargetError parse(std::string_view units);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table has the same unit classes with the same exponents as table. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    bool sameClasses(const UnitTable& table) const {
+        if ( _present != table._present ) {
+            return false;
+        }
+        for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class) {
+            if ( contains(unit_class) && _slots[unit_class].exponent != table._slots[unit_class].exponent ) {
+                return false;
+            }
+        }
+        return true;
+    }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table exponents of the SI base dimensions of its units of the classes in
+    ///             the mask dimensional (see dimensionalClassMask). </summary>
+    ///-------------------------------------------------------------------------------------------------
+    void dimensions(double dims[eDimCount], unsigned int dimensional) const {
+        // summed in locals, then stored
+        double sums[eDimCount] = { 0 };
+        int unit_class = 0;
+        for(unsigned int classes = _present & dimensional; classes; classes >>= 1, ++unit_class) {
+            if ( classes & 1 ) {
+                const signed char * dimension = unit_classes[unit_class].dimension;
+                const double exponent = _slots[unit_class].exponent;
+                for(int d = 0; d < eDimCount; ++d) {
+                    sums[d] += exponent*dimension[d];
+                }
+            }
+        }
+        for(int d = 0; d < eDimCount; ++d) {
+            dims[d] = sums[d];
+        }
+    }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table dimensions of its units of the classes in the mask dimensional packed
+    ///             by DIMENSION_KEY.  False if an exponent is not a whole number from
+    ///             -DIMENSION_KEY_MAX_EXPONENT to DIMENSION_KEY_MAX_EXPONENT. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    bool dimensionKey(long long& key, unsigned int dimensional) const {
+        key = 0;
+        int unit_class = 0;
+        for(unsigned int classes = _present & dimensional; classes; classes >>= 1, ++unit_class) {
+            if ( classes & 1 ) {
+                const double exponent = _slots[unit_class].exponent;
+                if ( !(exponent >= -DIMENSION_KEY_MAX_EXPONENT && exponent <= DIMENSION_KEY_MAX_EXPONENT)
+                     || exponent != (double)(int)exponent ) {
+                    return false;
+                }
+                key += (int)exponent*unit_classes[unit_class].dimension_key;
+            }
+        }
+        return true;
+    }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table hash of the dimensions of its units and of the other unit classes
+    ///             held with their exponents - equal for the tables of like terms (see
+    ///             BasicUnitGroup::areUnitsEqual). </summary>
+    ///-------------------------------------------------------------------------------------------------
+    unsigned int signatureHash(void) const {
+        const unsigned int dimensional = dimensionalClassMask();
+        unsigned int h = 2166136261u ^ (_present & ~dimensional);
+        int unit_class = 0;
+        for(unsigned int classes = _present & ~dimensional; classes; classes >>= 1, ++unit_class) {
+            if ( classes & 1 ) {
+                h = hashExponent(h, _slots[unit_class].exponent);
+            }
+        }
+        if ( _present & dimensional ) {
+            long long key = 0;
+            bool packed = dimensionKey(key, dimensional);
+            if ( !packed ) {
+                // whole dimensions hash as their key whichever exponents gave them
+                double dims[eDimCount];
+                dimensions(dims, dimensional);
+                packed = true;
+                for(int d = 0; d < eDimCount; ++d) {
+                    packed &= ( dims[d] > -(1 << (DIMENSION_KEY_BITS-1)) && dims[d] < (1 << (DIMENSION_KEY_BITS-1))
+                                && dims[d] == (double)(int)dims[d] );
+                }
+                if ( packed ) {
+                    key = DIMENSION_KEY((int)dims[0], (int)dims[1], (int)dims[2], (int)dims[3], (int)dims[4]);
+                }
+                else {
+                    for(int d = 0; d < eDimCount; ++d) {
+                        h = hashExponent(h, dims[d]);
+                    }
+                }
+            }
+            if ( packed ) {
+                h ^= (unsigned int)(key ^ (key >> 32));
+                h *= 16777619u;
+            }
+        }
+        // exponents are small whole numbers with no low bits set - mix them down
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+    void erase(int unit_class) { _present &= ~(1u << unit_class); }
+    void clear(void) { _present = 0; }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Table symbol of the current unit of unit_class. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    const char * symbol(int unit_class) const {
+        return unit_classes[unit_class].units[_slots[unit_class].cur_index];
+    }
+};
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Group. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             T is the value type - float, double or long double. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+class BasicUnitGroup {
+public:
+    typedef T value_type;
 private:
     // parameters of UnitGroup
-    double_uv _val;
+    T _val;
     char _oper;
-	MAP_ATOMIC_UNITS _units;
+	UnitTable _units;
 
-	friend class UnitGroup;
 	friend class Reducer;
 	friend class AtomicFormatter;
+	template<typename U> friend class BasicUnitGroup;
+	template<typename U> friend class BasicUValue;
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Value in the units of the group from the stored value and back. </summary>
+	///
+	/// <remarks>	Michael Ryan, 5/11/2012.
+	///             With UV_CANONICAL_STORAGE the units of linear classes are only what the value
+	///             is shown in, and _val holds it in the default unit of each of those classes.
+	///             Otherwise _val is the value in the units of the group. </remarks>
+	///-------------------------------------------------------------------------------------------------
+	T fromStored(T value) const;
+	T toStored(T value) const;
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Reduce with the unit named units, or else the unit given by rule (the SI unit
+	///             of the dimension if rule is nullptr). </summary>
+	///-------------------------------------------------------------------------------------------------
+	BasicUnitGroup& reduceWith(const char * units, const Reducer * rule);
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	With UV_AUTO_REDUCE defined, reduce the product or quotient of two groups.
+	///             Scalar factors, conversions and parsed units are left as they are. </summary>
+	///-------------------------------------------------------------------------------------------------
+	void reduceProduct(void);
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Replace the units matched by dimension with those of units, in one scale
+	///             through the SI units. </summary>
+	///-------------------------------------------------------------------------------------------------
+	void replaceDimensionalUnits(const UnitTable& units);
+	void replaceDimensionalUnits(const CrossClassRoute& route, int unit_index);
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Convert to the units of a parsed unit target - the classes held, each to the
+	///             power held, or else units of the dimensions of the group. </summary>
+	///-------------------------------------------------------------------------------------------------
+	UnitTargetError convertToTarget(const UnitTarget& target);
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Convert the units of the classes in covered to unit_index of each, with one
+	///             factor or else one class at a time. </summary>
+	///-------------------------------------------------------------------------------------------------
+	bool convertClasses(const short unit_index[eUnitClassCount], unsigned int covered);
+	bool convertClassesInOrder(const short unit_index[eUnitClassCount], unsigned int covered);
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Convert the classes held that have the unit abbrev. - eTargetUnknownUnit if
+	///             none has it. </summary>
+	///-------------------------------------------------------------------------------------------------
+	UnitTargetError convertHeld(std::string_view unit);
 	///-------------------------------------------------------------------------------------------------
 	/// <summary>	Unit Group Set Units. </summary>
 	///
 	/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 	///-------------------------------------------------------------------------------------------------
-	void setUnits(const MAP_ATOMIC_UNITS &units);
+	void setUnits(const UnitTable &units);
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Unit Group add unit to the Unit Table.  False if the unit's table is not a
+	///             registered unit class (see unitClassOfUnits) or the unit has more than
+	///             UNIT_SLOT_PARAMS parameters. </summary>
+	///
+	/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+	///-------------------------------------------------------------------------------------------------
+	bool setUnit(const AtomicUnit &unit);
 	///-------------------------------------------------------------------------------------------------
 	/// <summary>	Compare Unit Groups. </summary>
 	///
 	/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 	///-------------------------------------------------------------------------------------------------
-	int compareUnits(const MAP_ATOMIC_UNITS& units_in) const;
+	int compareUnits(const UnitTable& units_in) const;
 	///-------------------------------------------------------------------------------------------------
 	/// <summary>	Unit Groups Equal. </summary>
 	///
-	/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+	/// <remarks>	Michael Ryan, 5/11/2012.
+	///             Units are equal when they have the same SI dimensions and the same exponents
+	///             of the classes with no dimension (see dimensionalClassMask), so N and
+	///             kg*m/s^2 are like units. </remarks>
 	///-------------------------------------------------------------------------------------------------
-	bool areUnitsEqual(const MAP_ATOMIC_UNITS& units_in) const;
+	bool areUnitsEqual(const UnitTable& units_in) const;
 	///-------------------------------------------------------------------------------------------------
 	/// <summary>	Fold in units from operating Unit Group according to supplied operator. </summary>
 	///
 	/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 	///-------------------------------------------------------------------------------------------------
-	bool foldInUnit(char oper, const UnitGroup &unit) ;
+	bool foldInUnit(char oper, const BasicUnitGroup &unit) ;
 	///-------------------------------------------------------------------------------------------------
 	/// <summary>	Sum Units. </summary>
 	///
 	/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 	///-------------------------------------------------------------------------------------------------
-	bool sumUnits(char oper, const UnitGroup& unit);
+	bool sumUnits(char oper, const BasicUnitGroup& unit);
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Value of the like Unit Group unit in the units of this group.  False if it can
+	///             not be converted. </summary>
+	///-------------------------------------------------------------------------------------------------
+	bool likeValue(const BasicUnitGroup& unit, T& value) const;
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Factor from the SI units of the dimensions of the group to its units. </summary>
+	///
+	/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+	///-------------------------------------------------------------------------------------------------
+	T dimensionScale(void) const;
 public:
-    UnitGroup(void);
+    BasicUnitGroup(void);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Constructor. </summary>
     ///
@@ -343,152 +753,211 @@ public:
     ///         op - operator relation to other unit groups
     /// </parameters>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup(double_uv val, AtomicUnit * unit = nullptr, char op = 0);
+	BasicUnitGroup(T val, AtomicUnit * unit = nullptr, char op = 0);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Group Constructor from a unit value (copied into the group). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUnitGroup(T val, const AtomicUnit& unit, char op = 0);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Copy Constructor. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup(double_uv val, char oper, const MAP_ATOMIC_UNITS &units_in);
+	BasicUnitGroup(T val, char oper, const UnitTable &units_in);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Group Constructor from a unit expression, i.e. UnitGroup(9.8, "m/s^2"). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <parameters>
+    ///         val - value (NaN if units can not be parsed, see UnitTable::parse)
+    ///         units - unit expression
+    /// </parameters>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUnitGroup(T val, std::string_view units);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Group Constructor from a Unit Group of another precision. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	template<typename U>
+	explicit BasicUnitGroup(const BasicUnitGroup<U>& unit_in)
+		: _val((T)unit_in._val), _oper(unit_in.getOper()), _units(unit_in.getUnits()) {}
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Copy Constructor. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup(const UnitGroup& unit_in);
-    
+	BasicUnitGroup(const BasicUnitGroup& unit_in) = default;
+	BasicUnitGroup(BasicUnitGroup&& unit_in) = default;
     ///-------------------------------------------------------------------------------------------------
-    /// <summary>	Unit Group Destructor. </summary>
+    /// <summary>	Unit Group = Operator. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	~UnitGroup(void);
+	BasicUnitGroup& operator=(const BasicUnitGroup& unit_in) = default;
+	BasicUnitGroup& operator=(BasicUnitGroup&& unit_in) = default;
 	///-------------------------------------------------------------------------------------------------
 	/// <summary>	Sum Units. </summary>
 	///
 	/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 	///-------------------------------------------------------------------------------------------------
-	UnitGroup pow(double exponent) const;
+	BasicUnitGroup pow(double exponent) const;
 	///-------------------------------------------------------------------------------------------------
 	/// <summary>	Round to number of digits. </summary>
 	///
 	/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 	///-------------------------------------------------------------------------------------------------
-	UnitGroup roundTo(unsigned int num_of_digits) const;
+	BasicUnitGroup roundTo(unsigned int num_of_digits) const;
 	///-------------------------------------------------------------------------------------------------
 	/// <summary>	Reduce to more legible units series </summary>
 	///
-	/// <remarks>	Michael Ryan, 4/25/2016. </remarks>
+	/// <remarks>	Michael Ryan, 4/25/2016.
+	///             The units matched by dimension (see dimensionalClassMask) are replaced by one
+	///             unit of the class with their dimensions, found with one lookup of the derived
+	///             unit index, so (g*m)/(s^2) is reduced to N.  The unit is units if given, or else
+	///             the unit given by rule.  A group already of one such unit is left as it is
+	///             unless units names another unit of its class, as is a group of dimensions no
+	///             class has (i.e. s^2). </remarks>
 	///-------------------------------------------------------------------------------------------------
-	UnitGroup& reduce(const char * units, const Reducer& rule);
+	BasicUnitGroup& reduce(const char * units, const Reducer& rule);
+	///-------------------------------------------------------------------------------------------------
+	/// <summary>	Reduce to units, or to the SI unit of the dimensions of the group. </summary>
+	///
+	/// <remarks>	Michael Ryan, 4/25/2016.
+	///             With UV_AUTO_REDUCE defined every product and quotient of groups is reduced. </remarks>
+	///-------------------------------------------------------------------------------------------------
+	BasicUnitGroup& reduce(const char * units = nullptr);
 	///-------------------------------------------------------------------------------------------------
 	/// <summary>	Reduce to more legible units series </summary>
 	///
 	/// <remarks>	Michael Ryan, 4/25/2016. </remarks>
 	///-------------------------------------------------------------------------------------------------
-	UnitGroup& format(const char * units, const AtomicFormatter& format);
+	BasicUnitGroup& format(const char * units, const AtomicFormatter& format);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Comparison. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	bool operator==(const UnitGroup& unit) const;
+	bool operator==(const BasicUnitGroup& unit) const;
 	///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Multiplication. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup operator*(const UnitGroup& unit) const;
+	BasicUnitGroup operator*(const BasicUnitGroup& unit) const;
     ///-------------------------------------------------------------------------------------------------
-    /// <summary>	Unit Group Multiplication double_uv. </summary>
+    /// <summary>	Unit Group Multiplication by a value. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup operator*(const double_uv& val) const;
+	BasicUnitGroup operator*(const T& val) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group *=. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup& operator*=(const UnitGroup& unit);
+	BasicUnitGroup& operator*=(const BasicUnitGroup& unit);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Division. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup operator/(const UnitGroup& unit) const;
+	BasicUnitGroup operator/(const BasicUnitGroup& unit) const;
     ///-------------------------------------------------------------------------------------------------
-    /// <summary>	Unit Group Division double_uv. </summary>
+    /// <summary>	Unit Group Division by a value. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup operator/(const double_uv& val) const;
+	BasicUnitGroup operator/(const T& val) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group /=. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup& operator/=(const UnitGroup& unit);
+	BasicUnitGroup& operator/=(const BasicUnitGroup& unit);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group /=. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup& operator%=(const UnitGroup& unit);
+	BasicUnitGroup& operator%=(const BasicUnitGroup& unit);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Addition. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup operator+(const UnitGroup& unit) const;
+	BasicUnitGroup operator+(const BasicUnitGroup& unit) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group +=. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup& operator+=(const UnitGroup& unit);
+	BasicUnitGroup& operator+=(const BasicUnitGroup& unit);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Subtraction. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup operator-(const UnitGroup& unit) const;
+	BasicUnitGroup operator-(const BasicUnitGroup& unit) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group -=. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup& operator-=(const UnitGroup& unit);
+	BasicUnitGroup& operator-=(const BasicUnitGroup& unit);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Not Equals. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	bool operator!=(const UnitGroup& unit) const;
+	bool operator!=(const BasicUnitGroup& unit) const;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Group [] of unit abbrev., or of units joined by '*' and '/' (i.e. "km/h"). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012.
+    ///             Units that do not fit the group leave it as it is, see convertTo. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUnitGroup operator[](const char * pszNewUnits) const;
     ///-------------------------------------------------------------------------------------------------
-    /// <summary>	Unit Group [] of unit abbrev. </summary>
+    /// <summary>	Unit Group convert to units in place. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012.
+    ///             units are parsed by parseUnitTarget.  The units of the classes the group holds
+    ///             are converted to the units of the target with one factor for the whole group,
+    ///             and the target units of classes it does not hold are skipped.  If it holds
+    ///             none of them, its units are replaced by the target units of the same
+    ///             dimensions.  False (and the group unchanged) on an error, given in error if
+    ///             not nullptr. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	bool convertTo(const char * units, UnitTargetError * error = nullptr);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Group convert the unit of unit_class to unit index unit_index in place. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <returns>   false if the group has no unit of unit_class or the conversion failed (the
+    ///             group is unchanged) </returns>
     ///-------------------------------------------------------------------------------------------------
-	UnitGroup operator[](const char * pszNewUnits) const;
+	bool convertUnit(int unit_class, int unit_index);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Get Units List. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-    const MAP_ATOMIC_UNITS& getUnits(void) const;
+    const UnitTable& getUnits(void) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Get Value. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-    double_uv getValue(void) const;
+    T getValue(void) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Set Value. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-    void setValue(double_uv value);
+    void setValue(T value);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Get Oper. </summary>
     ///
@@ -507,7 +976,7 @@ public:
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	void deleteUnit(std::string id);
+	void deleteUnit(int unit_class);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Group Delete All Contained Units. </summary>
     ///
@@ -521,25 +990,211 @@ public:
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-std::ostream& operator<< (std::ostream& out, const UnitGroup& units);
+template<typename T>
+std::ostream& operator<< (std::ostream& out, const BasicUnitGroup<T>& units);
 
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Unit Value Container. </summary>
+/// <summary>	Term List - the terms of a Unit Value.  The first term is held inline so a
+///             Unit Value of one term makes no heap allocation.  Terms are contiguous and
+///             spill into the memory resource given (or the heap if none). </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-class UValue
+template<typename G>
+class TermList
 {
 private:
-    LIST_UNIT_GROUP _units;
+    G * _heap;          // terms once there is more than one, otherwise nullptr
+    size_t _size;
+    size_t _capacity;
+    std::pmr::memory_resource * _resource;  // nullptr for new/delete
+    alignas(G) unsigned char _first[sizeof(G)];
+
+    G * terms(void) { return _heap ? _heap : std::launder(reinterpret_cast<G *>(_first)); }
+    const G * terms(void) const { return _heap ? _heap : std::launder(reinterpret_cast<const G *>(_first)); }
+
+    G * allocate(size_t capacity) {
+        UV_COUNT_ALLOCATION(eAllocTerm, -1);
+        if ( _resource ) {
+            return static_cast<G *>(_resource->allocate(capacity*sizeof(G), alignof(G)));
+        }
+        return static_cast<G *>(::operator new(capacity*sizeof(G)));
+    }
+    void release(void) {
+        if ( _heap ) {
+            if ( _resource ) {
+                _resource->deallocate(_heap, _capacity*sizeof(G), alignof(G));
+            }
+            else {
+                ::operator delete(_heap);
+            }
+            _heap = nullptr;
+            _capacity = 1;
+        }
+    }
+
+    // takes the terms of list_in, which is left empty
+    void take(TermList& list_in) {
+        if ( list_in._heap && list_in._resource == _resource ) {
+            _heap = list_in._heap;
+            _size = list_in._size;
+            _capacity = list_in._capacity;
+            list_in._heap = nullptr;
+            list_in._size = 0;
+            list_in._capacity = 1;
+        }
+        else {
+            for(size_t i = 0; i < list_in._size; i++) {
+                push_back(std::move(list_in.terms()[i]));
+            }
+            list_in.clear();
+        }
+    }
+
+    void grow(size_t capacity) {
+        G * heap = allocate(capacity);
+        G * old = terms();
+        for(size_t i = 0; i < _size; i++) {
+            new (heap+i) G(std::move(old[i]));
+            old[i].~G();
+        }
+        release();
+        _heap = heap;
+        _capacity = capacity;
+    }
+public:
+    typedef G value_type;
+    typedef G * iterator;
+    typedef const G * const_iterator;
+
+    explicit TermList(std::pmr::memory_resource * resource = nullptr)
+        : _heap(nullptr), _size(0), _capacity(1), _resource(resource) {}
+    // a copy spills into the given resource, not the resource of list_in
+    TermList(const TermList& list_in, std::pmr::memory_resource * resource = nullptr)
+        : _heap(nullptr), _size(0), _capacity(1), _resource(resource) {
+        reserve(list_in._size);
+        for(const G& term : list_in) {
+            push_back(term);
+        }
+    }
+    TermList(TermList&& list_in) noexcept
+        : _heap(nullptr), _size(0), _capacity(1), _resource(list_in._resource) {
+        take(list_in);
+    }
+    ~TermList(void) {
+        clear();
+        release();
+    }
+
+    TermList& operator=(const TermList& list_in) {
+        if ( this != &list_in ) {
+            clear();
+            reserve(list_in._size);
+            for(const G& term : list_in) {
+                push_back(term);
+            }
+        }
+        return *this;
+    }
+    // not noexcept - the terms of a list in another resource are moved one by one into this
+    // list's resource, which may throw
+    TermList& operator=(TermList&& list_in) {
+        if ( this != &list_in ) {
+            clear();
+            if ( list_in._resource == _resource ) {
+                release();
+            }
+            take(list_in);
+        }
+        return *this;
+    }
+
+    iterator begin(void) { return terms(); }
+    iterator end(void) { return terms() + _size; }
+    const_iterator begin(void) const { return terms(); }
+    const_iterator end(void) const { return terms() + _size; }
+
+    size_t size(void) const { return _size; }
+    bool empty(void) const { return _size == 0; }
+    std::pmr::memory_resource * resource(void) const { return _resource; }
+    G& front(void) { return terms()[0]; }
+    const G& front(void) const { return terms()[0]; }
+    G& back(void) { return terms()[_size-1]; }
+    const G& back(void) const { return terms()[_size-1]; }
+    G& operator[](size_t index) { return terms()[index]; }
+    const G& operator[](size_t index) const { return terms()[index]; }
+
+    void reserve(size_t capacity) {
+        if ( capacity > _capacity ) {
+            grow(capacity);
+        }
+    }
+    void push_back(const G& term) {
+        if ( _size == _capacity ) {
+            // term may be one of our own
+            G copy(term);
+            grow(_capacity*2);
+            new (terms()+_size) G(std::move(copy));
+        }
+        else {
+            new (terms()+_size) G(term);
+        }
+        _size++;
+    }
+    void push_back(G&& term) {
+        if ( _size == _capacity ) {
+            G moved(std::move(term));
+            grow(_capacity*2);
+            new (terms()+_size) G(std::move(moved));
+        }
+        else {
+            new (terms()+_size) G(std::move(term));
+        }
+        _size++;
+    }
+    iterator erase(iterator position) {
+        iterator last = end() - 1;
+        for(iterator iter = position; iter != last; ++iter) {
+            *iter = std::move(*(iter+1));
+        }
+        last->~G();
+        _size--;
+        return position;
+    }
+    void clear(void) {
+        G * t = terms();
+        for(size_t i = 0; i < _size; i++) {
+            t[i].~G();
+        }
+        _size = 0;
+    }
+};
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Container. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             T is the value type - float, double or long double. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+class BasicUValue
+{
+public:
+    typedef T value_type;
+    typedef TermList<BasicUnitGroup<T> > UnitGroupList;
+private:
+    UnitGroupList _units;
     double _exponent;
+
+    friend class BasicUValueView<T>;
+    template<typename U, typename E> friend class UExpr;
 public:
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Default Constructor. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/09/2014. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue(void);
+	BasicUValue(void);
 	///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Constructor. </summary>
     ///
@@ -549,7 +1204,50 @@ public:
     ///         unit - Unit pointer (Unit Value will manage this object from now on.  Do not delete.)
     /// </parameters>
     ///-------------------------------------------------------------------------------------------------
-	UValue(double_uv init_val, AtomicUnit * unit = nullptr);
+	BasicUValue(T init_val, AtomicUnit * unit = nullptr);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Constructor from a unit value, i.e. UValue(5.0, DistUnit("m")). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <parameters>
+    ///         init_val - initial value
+    ///         unit - unit (copied, nothing is allocated)
+    /// </parameters>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValue(T init_val, const AtomicUnit& unit);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Constructor from a unit index, i.e.
+    ///             UValue(5.0, eUnitDist, unitIndexInClass(eUnitDist, "m")). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <parameters>
+    ///         init_val - initial value (NaN if the unit index is not in the unit class)
+    ///         unit_class - unit class
+    ///         unit_index - index of the unit in the class's units
+    ///         exponent - exponent of the unit
+    /// </parameters>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValue(T init_val, UnitClassId unit_class, int unit_index, double exponent = 1);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Constructor from a Unit Record. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <parameters>
+    ///         init_val - initial value (NaN if the record is not a unit of a unit class)
+    ///         unit - unit record
+    /// </parameters>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValue(T init_val, const UnitRecord& unit);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Constructor from a unit expression, i.e. UValue(9.8, "m/s^2"). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <parameters>
+    ///         init_val - initial value (NaN if units can not be parsed, see UnitTable::parse)
+    ///         units - unit expression
+    /// </parameters>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValue(T init_val, std::string_view units);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Constructor. </summary>
     ///
@@ -559,26 +1257,71 @@ public:
     ///         unit - Unit pointer (Unit Value will manage this object from now on.  Do not delete.)
     /// </parameters>
     ///-------------------------------------------------------------------------------------------------
-	UValue(double_uv init_val, const LIST_UNIT_GROUP &group_in);
+	BasicUValue(T init_val, const UnitGroupList &group_in);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Constructor allocating its terms from a memory resource. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <parameters>
+    ///         init_val - initial value
+    ///         unit - Unit pointer (Unit Value will manage this object from now on.  Do not delete.)
+    ///         resource - memory resource of the terms (must outlive the Unit Value)
+    /// </parameters>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValue(T init_val, AtomicUnit * unit, std::pmr::memory_resource * resource);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Copy Constructor. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue(const UValue& val_in);
+	BasicUValue(const BasicUValue& val_in);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Copy Constructor allocating from a memory resource. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012.
+    ///             A plain copy uses the heap, like the std::pmr containers. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValue(const BasicUValue& val_in, std::pmr::memory_resource * resource);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Move Constructor. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValue(BasicUValue&& val_in) noexcept;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Constructor from a Unit Value of another precision. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	template<typename U>
+	explicit BasicUValue(const BasicUValue<U>& val_in)
+		: _exponent(1) {
+		for(const BasicUnitGroup<U>& group : val_in.getUnits()) {
+			_units.push_back(BasicUnitGroup<T>(group));
+		}
+	}
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Constructor from a single term. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	explicit BasicUValue(const BasicUnitGroup<T>& term)
+		: _exponent(1) {
+		_units.push_back(term);
+	}
     
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Copy Constructor. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue(const LIST_UNIT_GROUP units_in, double exponent);
+	BasicUValue(const UnitGroupList& units_in, double exponent);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Destructor. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	~UValue(void);
+	~BasicUValue(void);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Get number of terms. </summary>
     ///
@@ -590,135 +1333,155 @@ public:
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	double_uv getValue(size_t termIndex = 0) const;
+	T getValue(size_t termIndex = 0) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Get List of Polynomial Parameters. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	std::list<double_uv> getValues(void) const;
+	std::list<T> getValues(void) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Set First Polynomial Value. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	void setValue(double_uv val);
+	void setValue(T val);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Get First Unit. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	const char *const getUnit(void);
+	const char * getUnit(void);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Get All Unit Groups. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	LIST_UNIT_GROUP getUnits(void) const;
+	const UnitGroupList& getUnits(void) const;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Memory resource of the terms (nullptr for the heap). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	std::pmr::memory_resource * getResource(void) const { return _units.resource(); }
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Set Unit Groups. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-    void setUnits(const LIST_UNIT_GROUP &units);
+    void setUnits(const UnitGroupList &units);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Round To Number of Digits. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-    UValue roundTo(unsigned int num_of_digits) const;
+    BasicUValue roundTo(unsigned int num_of_digits) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value = Operator. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue& operator=(const UValue& val_in);
+	BasicUValue& operator=(const BasicUValue& val_in);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Move = Operator. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012.
+    ///             The value keeps its memory resource, so the terms of a value in another
+    ///             resource are moved into it one by one and the allocation may throw. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValue& operator=(BasicUValue&& val_in);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Comparison Operator. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	bool operator==(const UValue& val_in) const;
+	bool operator==(const BasicUValue& val_in) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Not Equal Operator. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	bool operator!=(const UValue& val_in) const;
+	bool operator!=(const BasicUValue& val_in) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Multiplication. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue operator*(const UValue& val) const;
+	BasicUValue operator*(const BasicUValue& val) const &;
+	BasicUValue operator*(const BasicUValue& val) &&;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Multiplication double_uv. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue operator*(const double_uv& val) const;
+	BasicUValue operator*(const T& val) const &;
+	BasicUValue operator*(const T& val) &&;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Division. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue operator/(const UValue& val) const;
+	BasicUValue operator/(const BasicUValue& val) const &;
+	BasicUValue operator/(const BasicUValue& val) &&;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Division double_uv. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue operator/(const double_uv& val) const;
+	BasicUValue operator/(const T& val) const &;
+	BasicUValue operator/(const T& val) &&;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Addition. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue operator+(const UValue& val) const;
+	BasicUValue operator+(const BasicUValue& val) const &;
+	BasicUValue operator+(const BasicUValue& val) &&;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Subtraction. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue operator-(const UValue& val) const;
+	BasicUValue operator-(const BasicUValue& val) const &;
+	BasicUValue operator-(const BasicUValue& val) &&;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value +=. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue& operator*=(const UValue& val);
+	BasicUValue& operator*=(const BasicUValue& val);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value /=. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue& operator/=(const UValue& val);
+	BasicUValue& operator/=(const BasicUValue& val);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value +=. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue& operator+=(const UValue& val);
+	BasicUValue& operator+=(const BasicUValue& val);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value -=. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue& operator-=(const UValue& val);
+	BasicUValue& operator-=(const BasicUValue& val);
     /*
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value <. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	bool operator<(const UValue& val) const {
+	bool operator<(const BasicUValue& val) const {
 		bool is_less_than = false;
-		const LIST_UNIT_GROUP& val_units = val.getUnits();
+		const UnitGroupList& val_units = val.getUnits();
 
-		for(LIST_UNIT_GROUP::const_iterator val_iter = val_units.begin();
+		for(UnitGroupList::const_iterator val_iter = val_units.begin();
 			val_iter != val_units.end();
 			val_iter++) {
-			LIST_UNIT_GROUP::const_iterator iter = _units.begin();
+			UnitGroupList::const_iterator iter = _units.begin();
 			bool are_equal = false;
 			for(;
 				iter != _units.end() && !are_equal;
@@ -734,7 +1497,7 @@ public:
 			else {
 				// comparing apples to oranges
 				is_less_than = false;
-				//write_error("False comparision.  Two different UValue objects.");
+				//write_error("False comparision.  Two different BasicUValue objects.");
 				break;
 			}
 		}
@@ -743,11 +1506,29 @@ public:
 	}
     */
     ///-------------------------------------------------------------------------------------------------
-    /// <summary>	Unit Value [] with unit abbrev. </summary>
+    /// <summary>	Unit Value [] with unit abbrev., or with units joined by '*' and '/'. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue operator[](const char * pszNewUnits) const;
+	BasicUValue operator[](const char * pszNewUnits) const &;
+	BasicUValue operator[](const char * pszNewUnits) &&;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value convert each term to units in place. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012.
+    ///             See BasicUnitGroup::convertTo.  False if a term could not be converted, with
+    ///             the error of the first such term in error if not nullptr. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	bool convertTo(const char * units, UnitTargetError * error = nullptr);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value lazy [] - a view of this Unit Value in other units. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012.
+    ///             Nothing is copied or converted until the view is read, printed or turned
+    ///             into a Unit Value, and v.as("cm")["in"]["ft"] converts once, to ft.
+    ///             The view refers to this Unit Value, which must outlive it. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValueView<T> as(const char * pszNewUnits) const;
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value print. </summary>
     ///
@@ -765,22 +1546,44 @@ public:
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value get unit to power of exponent </summary>
     ///
-    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <remarks>	Michael Ryan, 5/11/2012.
+    ///             A single term has its exponents scaled.  The whole part of the power of a
+    ///             polynomial is expanded with like terms combined, and only what is left of the
+    ///             power (a root, or -1 for a reciprocal) is held as its exponent. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValue pow(double exponent) const;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value with each term reduced to units, or to the SI unit of its dimensions
+    ///             (see BasicUnitGroup::reduce). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 4/25/2016. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	UValue pow(double exponent) const;
+	BasicUValue reduce(const char * units = nullptr) const;
 private:
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value multiply terms - product of two polynomials. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    static void multiplyTerms(UnitGroupList& product, const UnitGroupList& left, const UnitGroupList& right);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value fold units. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	bool foldIntoUnits(char oper, const UValue& val_in, bool simplify = false);
+	bool foldIntoUnits(char oper, const BasicUValue& val_in, bool simplify = false);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value sum in units. </summary>
     ///
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
-	bool sumInUnits(char oper, const UValue& units_in, bool simplify = false);
+	bool sumInUnits(char oper, const BasicUValue& units_in, bool simplify = false);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value scale every term by a unitless value. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	void foldInScalar(char oper, T val);
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Unit Value Delete Unit at Index. </summary>
     ///
@@ -793,38 +1596,128 @@ private:
     /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
     ///-------------------------------------------------------------------------------------------------
 	void deleteAllUnits(void);
-}; // class UValue
+}; // class BasicUValue
 
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Multiplication. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue operator*(double_uv val1, const UValue& val2);
+template<typename T>
+BasicUValue<T> operator*(typename BasicUValue<T>::value_type val1, const BasicUValue<T>& val2);
+template<typename T>
+BasicUValue<T> operator*(typename BasicUValue<T>::value_type val1, BasicUValue<T>&& val2);
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Addition. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue operator+(double_uv val1, const UValue& val2);
+template<typename T>
+BasicUValue<T> operator+(typename BasicUValue<T>::value_type val1, const BasicUValue<T>& val2);
+template<typename T>
+BasicUValue<T> operator+(typename BasicUValue<T>::value_type val1, BasicUValue<T>&& val2);
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Subtraction. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue operator-(double_uv val1, const UValue& val2);
+template<typename T>
+BasicUValue<T> operator-(typename BasicUValue<T>::value_type val1, const BasicUValue<T>& val2);
+template<typename T>
+BasicUValue<T> operator-(typename BasicUValue<T>::value_type val1, BasicUValue<T>&& val2);
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Division. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue operator/(double_uv val1, const UValue& val2);
+template<typename T>
+BasicUValue<T> operator/(typename BasicUValue<T>::value_type val1, const BasicUValue<T>& val2);
+template<typename T>
+BasicUValue<T> operator/(typename BasicUValue<T>::value_type val1, BasicUValue<T>&& val2);
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value <<. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-std::ostream& operator<<(std::ostream& out, const UValue& val);
+template<typename T>
+std::ostream& operator<<(std::ostream& out, const BasicUValue<T>& val);
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value View - a Unit Value and the units it is to be shown in. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             Each [] replaces the target unit of the unit classes it names, so a chain of
+///             conversions is one conversion per unit class when the view is read. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+class BasicUValueView
+{
+private:
+    const BasicUValue<T> * _source;
+    // unit classes of the terms of the source
+    unsigned int _classes;
+    // target unit index per unit class (-1 to keep the unit of the source)
+    short _targets[eUnitClassCount];
+
+    void applyTargets(BasicUnitGroup<T>& group) const;
+public:
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value View Constructor. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <parameters>
+    ///         source - Unit Value viewed (must outlive the view)
+    ///         pszNewUnits - unit abbrev. to view the value in
+    /// </parameters>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValueView(const BasicUValue<T>& source, const char * pszNewUnits);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value View [] with unit abbrev. - replaces the target of its unit class. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValueView operator[](const char * pszNewUnits) const;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value View Get Polynomial Term in the target units (default is zero). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	T getValue(size_t termIndex = 0) const;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value View print. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	std::string print(int precision = -1,
+		std::ios::fmtflags notation = std::ios::scientific,
+                      std::ios::fmtflags mask = std::ios::floatfield ) const;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value View converted into a Unit Value. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+	BasicUValue<T> materialize(void) const;
+	operator BasicUValue<T>() const { return materialize(); }
+};
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value View <<. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+std::ostream& operator<<(std::ostream& out, const BasicUValueView<T>& view);
+
+// the precisions built into the library
+extern template class BasicUnitGroup<float>;
+extern template class BasicUnitGroup<double>;
+extern template class BasicUnitGroup<long double>;
+extern template class BasicUValue<float>;
+extern template class BasicUValue<double>;
+extern template class BasicUValue<long double>;
+extern template class BasicUValueView<float>;
+extern template class BasicUValueView<double>;
+extern template class BasicUValueView<long double>;
 
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Macro for common form of static bool isAllowableUnit method </summary>
@@ -832,16 +1725,17 @@ std::ostream& operator<<(std::ostream& out, const UValue& val);
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
 
-#define STATIC_UNIT_MTHDS(pUnit, pUnitsArr, iUnitsArrLen)               \
+#define STATIC_UNIT_MTHDS(unit_class_id)                                \
 static bool isAllowableUnit(const char * pUnit) {                       \
-    return foundUnitInUnits(pUnit, pUnitsArr, iUnitsArrLen);            \
+    return foundUnitInUnits(pUnit, unit_classes[unit_class_id].units,   \
+                            unit_classes[unit_class_id].units_len);     \
 }                                                                       \
 static const char *const* getUnits(void) {                              \
-    return pUnitsArr;                                                   \
+    return unit_classes[unit_class_id].units;                           \
 }                                                                       \
 static int getUnitsLen(void) {                                          \
-    return iUnitsArrLen;                                                \
-}	
+    return unit_classes[unit_class_id].units_len;                       \
+}
 
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Frequency Unit. </summary>
@@ -853,21 +1747,13 @@ class FrequencyUnit
 	: public AtomicUnit
 {
 public:
-	explicit FrequencyUnit(const char * cur_units = "MHz")
-		: AtomicUnit(freqs, freqs_len, FreqConversion, cur_units, "MHz") 
-	{
-	}
-
-	FrequencyUnit * create() 
-	{
-		return new FrequencyUnit();
-	}
+    static const UnitClassId class_id = eUnitFrequency;
 
-	FrequencyUnit * clone() const
+	explicit FrequencyUnit(const char * cur_units = "MHz")
+		: AtomicUnit(class_id, cur_units)
 	{
-		return new FrequencyUnit(*this);
 	}
-    STATIC_UNIT_MTHDS(pUNit, freqs, freqs_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -879,29 +1765,23 @@ class AmplUnit
 	: public AtomicUnit
 {
 public:
+    static const UnitClassId class_id = eUnitAmpl;
+
 	explicit AmplUnit(const char * cur_units = "dBm")
-		: AtomicUnit(ampls, ampls_len, AmplConversion, cur_units, "dBm")
+		: AtomicUnit(class_id, cur_units)
 	{
 	}
 
-	AmplUnit * create(void)
-	{
-		return new AmplUnit();
-	}
 
-	AmplUnit * clone(void) const
-	{
-		return new AmplUnit(*this);
-	}
-    void setImpedance(double_uv impedance)
+    void setImpedance(engine_uv impedance)
     {
         this->setParam(impedance, 0);
     }
-    double_uv getImpedance(void)
+    engine_uv getImpedance(void)
     {
         return this->getParam(0);
     }
-    STATIC_UNIT_MTHDS(pUNit, ampls, ampls_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -913,20 +1793,13 @@ class TimeUnit
 	: public AtomicUnit
 {
 public:
-	TimeUnit(const char * cur_units = "s")
-		: AtomicUnit(times, times_len, TimeConversion, cur_units, "s")
-	{
-	}
+    static const UnitClassId class_id = eUnitTime;
 
-	TimeUnit * create(void)
-	{
-		return new TimeUnit();
-	}
-	TimeUnit * clone(void) const
+	TimeUnit(const char * cur_units = "s")
+		: AtomicUnit(class_id, cur_units)
 	{
-		return new TimeUnit(*this);
 	}
-    STATIC_UNIT_MTHDS(pUNit, times, times_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -938,20 +1811,13 @@ class DistUnit
 	: public AtomicUnit
 {
 public:
-	DistUnit(const char * cur_units = "m")
-		: AtomicUnit(dists, dists_len, DistanceConversion, cur_units, "m")
-	{
-	}
+    static const UnitClassId class_id = eUnitDist;
 
-	DistUnit * create(void)
-	{
-		return new DistUnit();
-	}
-	DistUnit * clone(void) const
+	DistUnit(const char * cur_units = "m")
+		: AtomicUnit(class_id, cur_units)
 	{
-		return new DistUnit(*this);
 	}
-    STATIC_UNIT_MTHDS(pUNit, dists, dists_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -963,20 +1829,13 @@ class TempUnit
 	: public AtomicUnit
 {
 public:
-	TempUnit(const char * cur_units="C")
-		: AtomicUnit(temps_units, temps_units_len, TempConversion, cur_units, "C")
-	{
-	}
+    static const UnitClassId class_id = eUnitTemp;
 
-	TempUnit * create(void)
-	{
-		return new TempUnit();
-	}
-	TempUnit * clone(void) const
+	TempUnit(const char * cur_units="C")
+		: AtomicUnit(class_id, cur_units)
 	{
-		return new TempUnit(*this);
 	}
-    STATIC_UNIT_MTHDS(pUNit, temps_units, temps_units_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -988,20 +1847,13 @@ class CurrentUnit
 	: public AtomicUnit
 {
 public:
-	CurrentUnit(const char * cur_units="A")
-		: AtomicUnit(currents, currents_len, CurrentConversion, cur_units, "A")
-	{
-	}
+    static const UnitClassId class_id = eUnitCurrent;
 
-	CurrentUnit * create(void)
-	{
-		return new CurrentUnit();
-	}
-	CurrentUnit * clone(void) const
+	CurrentUnit(const char * cur_units="A")
+		: AtomicUnit(class_id, cur_units)
 	{
-		return new CurrentUnit(*this);
 	}
-    STATIC_UNIT_MTHDS(pUNit, currents, currents_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -1013,20 +1865,14 @@ class VolumeUnit
 : public AtomicUnit
 {
 public:
+    static const UnitClassId class_id = eUnitVolume;
+
 	VolumeUnit(const char * cur_units="l")
-        : AtomicUnit(volumes, volumes_len, VolumeConversion, cur_units, "l")
+        : AtomicUnit(class_id, cur_units)
 	{
 	}
     
-	VolumeUnit * create(void)
-	{
-		return new VolumeUnit();
-	}
-	VolumeUnit * clone(void) const
-	{
-		return new VolumeUnit(*this);
-	}
-    STATIC_UNIT_MTHDS(pUNit, volumes, volumes_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -1038,20 +1884,14 @@ class MassUnit
 : public AtomicUnit
 {
 public:
+    static const UnitClassId class_id = eUnitMass;
+
 	MassUnit(const char * cur_units="g")
-        : AtomicUnit(masses, masses_len, MassConversion, cur_units, "g")
+        : AtomicUnit(class_id, cur_units)
 	{
 	}
     
-	MassUnit * create(void)
-	{
-		return new MassUnit();
-	}
-	MassUnit * clone(void) const
-	{
-		return new MassUnit(*this);
-	}
-    STATIC_UNIT_MTHDS(pUNit, masses, masses_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -1063,20 +1903,14 @@ class ForceUnit
 : public AtomicUnit
 {
 public:
+    static const UnitClassId class_id = eUnitForce;
+
 	ForceUnit(const char * cur_units="N")
-        : AtomicUnit(forces, forces_len, ForceConversion, cur_units, "N")
+        : AtomicUnit(class_id, cur_units)
 	{
 	}
     
-	ForceUnit * create(void)
-	{
-		return new ForceUnit();
-	}
-	ForceUnit * clone(void) const
-	{
-		return new ForceUnit(*this);
-	}
-    STATIC_UNIT_MTHDS(pUNit, forces, forces_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -1088,20 +1922,14 @@ class PressureUnit
 : public AtomicUnit
 {
 public:
+    static const UnitClassId class_id = eUnitPressure;
+
 	PressureUnit(const char * cur_units="Pa")
-        : AtomicUnit(pressures, pressures_len, PressureConversion, cur_units, "Pa")
+        : AtomicUnit(class_id, cur_units)
 	{
 	}
     
-	PressureUnit * create(void)
-	{
-		return new PressureUnit();
-	}
-	PressureUnit * clone(void) const
-	{
-		return new PressureUnit(*this);
-	}
-    STATIC_UNIT_MTHDS(pUNit, pressures, pressures_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -1113,20 +1941,14 @@ class EnergyUnit
 : public AtomicUnit
 {
 public:
+    static const UnitClassId class_id = eUnitEnergy;
+
 	EnergyUnit(const char * cur_units="J")
-        : AtomicUnit(energies, energies_len, EnergyConversion, cur_units, "J")
+        : AtomicUnit(class_id, cur_units)
 	{
 	}
     
-	EnergyUnit * create(void)
-	{
-		return new EnergyUnit();
-	}
-	EnergyUnit * clone(void) const
-	{
-		return new EnergyUnit(*this);
-	}
-    STATIC_UNIT_MTHDS(pUNit, energies, energies_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -1138,20 +1960,14 @@ class PowerUnit
 : public AtomicUnit
 {
 public:
+    static const UnitClassId class_id = eUnitPower;
+
 	PowerUnit(const char * cur_units="W")
-        : AtomicUnit(powers, powers_len, PowerConversion, cur_units, "W")
+        : AtomicUnit(class_id, cur_units)
 	{
 	}
     
-	PowerUnit * create(void)
-	{
-		return new PowerUnit();
-	}
-	PowerUnit * clone(void) const
-	{
-		return new PowerUnit(*this);
-	}
-    STATIC_UNIT_MTHDS(pUNit, powers, powers_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -1163,20 +1979,13 @@ class AngleUnit
 : public AtomicUnit
 {
 public:
+    static const UnitClassId class_id = eUnitAngle;
+
     AngleUnit(const char * cur_units="deg")
-    : AtomicUnit(angles, angles_len, AngleConversion, cur_units, "deg")
+    : AtomicUnit(class_id, cur_units)
     {
     }
-    
-    AngleUnit * create(void)
-    {
-        return new AngleUnit();
-    }
-    AngleUnit * clone(void) const
-    {
-        return new AngleUnit(*this);
-    }
-    STATIC_UNIT_MTHDS(pUNit, angles, angles_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 ///-------------------------------------------------------------------------------------------------
@@ -1188,20 +1997,13 @@ class AreaUnit
 : public AtomicUnit
 {
 public:
+    static const UnitClassId class_id = eUnitArea;
+
     AreaUnit(const char * cur_units="sq m")
-    : AtomicUnit(areas, areas_len, AreaConversion, cur_units, "sq m")
-    {
-    }
-    
-    AreaUnit * create(void)
-    {
-        return new AreaUnit();
-    }
-    AreaUnit * clone(void) const
+    : AtomicUnit(class_id, cur_units)
     {
-        return new AreaUnit(*this);
     }
-    STATIC_UNIT_MTHDS(pUNit, areas, areas_len);
+    STATIC_UNIT_MTHDS(class_id);
 };
 
 
@@ -0,0 +1,199 @@
+///-------------------------------------------------------------------------------------------------
+// file:	UValueArray.hpp
+//
+// summary:	Declares the BasicUValueArray class - a column of values sharing one unit signature
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+#include "UValue.hpp"
+
+#ifndef __UVALUE_ARRAY_H__
+#define __UVALUE_ARRAY_H__
+
+// alignment of the value buffer of a UValueArray
+#define UVALUE_ARRAY_ALIGNMENT                      64
+
+template<typename T> class BasicUValueArray;
+
+// UValueArray holds double_uv values - the other precisions are BasicUValueArray<float> etc.
+typedef BasicUValueArray<double_uv> UValueArray;
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Array - one unit signature and a contiguous buffer of values. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             Operations that are not possible (sums of different units or UValues
+///             of more than one term) leave NaN in the affected values. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+class BasicUValueArray
+{
+private:
+    UnitTable _units;
+    T * _values;
+    size_t _size;
+    size_t _capacity;
+public:
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array Default Constructor (unitless and empty). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    BasicUValueArray(void);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array Constructor. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <parameters>
+    ///         count - number of values
+    ///         unit - unit of every value (copied, the caller keeps ownership)
+    ///         init_val - initial value
+    /// </parameters>
+    ///-------------------------------------------------------------------------------------------------
+    BasicUValueArray(size_t count, const AtomicUnit& unit, T init_val = 0);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array Constructor from a buffer of values. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    BasicUValueArray(const T * values, size_t count, const AtomicUnit& unit);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array Constructor repeating a single term Unit Value. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    BasicUValueArray(size_t count, const BasicUValue<T>& init_val);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array Copy Constructor. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    BasicUValueArray(const BasicUValueArray& array_in);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array Move Constructor. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    BasicUValueArray(BasicUValueArray&& array_in) noexcept;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array Destructor. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    ~BasicUValueArray(void);
+
+    BasicUValueArray& operator=(const BasicUValueArray& array_in);
+    BasicUValueArray& operator=(BasicUValueArray&& array_in) noexcept;
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array number of values. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    size_t size(void) const { return _size; }
+    bool empty(void) const { return _size == 0; }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array contiguous values (UVALUE_ARRAY_ALIGNMENT aligned). </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    T * data(void) { return _values; }
+    const T * data(void) const { return _values; }
+    T getValue(size_t index) const { return _values[index]; }
+    void setValue(size_t index, T val) { _values[index] = val; }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array unit signature shared by every value. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    const UnitTable& getUnits(void) const { return _units; }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array element as a Unit Value. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    BasicUValue<T> at(size_t index) const;
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array set element from a single term Unit Value. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <returns>   false if val does not have the units of the array </returns>
+    ///-------------------------------------------------------------------------------------------------
+    bool set(size_t index, const BasicUValue<T>& val);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array append a value in the units of the array. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    void push_back(T val);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array append a single term Unit Value. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    /// <returns>   false if val does not have the units of the array </returns>
+    ///-------------------------------------------------------------------------------------------------
+    bool push_back(const BasicUValue<T>& val);
+    void reserve(size_t capacity);
+    void resize(size_t count, T val = 0);
+    void clear(void) { _size = 0; }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array [] with unit abbrev. - converts the whole column. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    BasicUValueArray operator[](const char * pszNewUnits) const &;
+    BasicUValueArray operator[](const char * pszNewUnits) &&;
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array element-wise operators.  Scalars are unitless for * and /
+    ///             and in the units of the array for + and -. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    BasicUValueArray& operator*=(const BasicUValueArray& array_in);
+    BasicUValueArray& operator/=(const BasicUValueArray& array_in);
+    BasicUValueArray& operator+=(const BasicUValueArray& array_in);
+    BasicUValueArray& operator-=(const BasicUValueArray& array_in);
+    BasicUValueArray& operator*=(const BasicUValue<T>& val);
+    BasicUValueArray& operator/=(const BasicUValue<T>& val);
+    BasicUValueArray& operator+=(const BasicUValue<T>& val);
+    BasicUValueArray& operator-=(const BasicUValue<T>& val);
+    BasicUValueArray& operator*=(T val);
+    BasicUValueArray& operator/=(T val);
+    BasicUValueArray& operator+=(T val);
+    BasicUValueArray& operator-=(T val);
+
+    BasicUValueArray operator*(const BasicUValueArray& array_in) const;
+    BasicUValueArray operator/(const BasicUValueArray& array_in) const;
+    BasicUValueArray operator+(const BasicUValueArray& array_in) const;
+    BasicUValueArray operator-(const BasicUValueArray& array_in) const;
+    BasicUValueArray operator*(const BasicUValue<T>& val) const;
+    BasicUValueArray operator/(const BasicUValue<T>& val) const;
+    BasicUValueArray operator+(const BasicUValue<T>& val) const;
+    BasicUValueArray operator-(const BasicUValue<T>& val) const;
+    BasicUValueArray operator*(T val) const;
+    BasicUValueArray operator/(T val) const;
+    BasicUValueArray operator+(T val) const;
+    BasicUValueArray operator-(T val) const;
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Array printUnits. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    std::string printUnits(void) const;
+private:
+    bool foldIn(char oper, const UnitTable& units_in, const T * values_in, size_t stride);
+    bool sumIn(char oper, const UnitTable& units_in, const T * values_in, size_t stride);
+    void fillNaN(void);
+}; // class BasicUValueArray
+
+// the precisions built into the library
+extern template class BasicUValueArray<float>;
+extern template class BasicUValueArray<double>;
+extern template class BasicUValueArray<long double>;
+
+#endif // __UVALUE_ARRAY_H__
@@ -0,0 +1,56 @@
+///-------------------------------------------------------------------------------------------------
+// file:	UValueCounters.h
+//
+// summary:	Declares the hot path counters - clones, heap allocations, conversions and
+//          NaN results of the calling thread.  The counters are only kept when the library
+//          and its users are built with UV_ENABLE_COUNTERS, otherwise they read as zero.
+//          With UV_CANONICAL_STORAGE a value of a linear class is converted to the default
+//          unit of the class when it is made or set, and from it when it is read (getValue,
+//          print), so those calls count the conversions that [] and arithmetic count otherwise.
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+#include <vector>
+#include "Conversions.h"
+
+#ifndef __UVALUE_COUNTERS_H__
+#define __UVALUE_COUNTERS_H__
+
+typedef struct {
+    // AtomicUnit clones per unit class
+    unsigned long long clones[eUnitClassCount];
+    // heap allocations per AllocationSite
+    unsigned long long allocations[eAllocSiteCount];
+    // heap allocations made for units of a unit class (parameters lists)
+    unsigned long long class_allocations[eUnitClassCount];
+    // values converted per unit class, indexed in*units_len + out (empty if none)
+    std::vector<unsigned long long> conversions[eUnitClassCount];
+    // conversions per unit class that resulted in NaN
+    unsigned long long nan_results[eUnitClassCount];
+    // values converted by the SSE2/AVX2 kernels of the bulk conversions
+    unsigned long long vector_values;
+} HotPathCounters;
+
+/*
+ Returns true if the library was built with UV_ENABLE_COUNTERS
+ */
+bool countersEnabled(void);
+
+/*
+ Copy of the counters of the calling thread
+ */
+HotPathCounters countersSnapshot(void);
+
+/*
+ Zeros the counters of the calling thread
+ */
+void resetCounters(void);
+
+/*
+ Values converted from unit index in to unit index out of a unit class in a snapshot
+ */
+unsigned long long conversionCount(const HotPathCounters& counters, int unit_class, int in, int out);
+
+#endif // __UVALUE_COUNTERS_H__
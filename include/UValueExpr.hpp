@@ -0,0 +1,226 @@
+///-------------------------------------------------------------------------------------------------
+// file:	UValueExpr.hpp
+//
+// summary:	Declares the opt-in expression templates of Unit Value arithmetic.  uvExpr(a)*b/(c*c) + d
+//          is a tree of nodes until it is assigned to a Unit Value, and is then folded term by
+//          term into one Unit Group - one unit signature and the value - with no temporary
+//          Unit Values in between.
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#pragma once
+#include "UValue.hpp"
+
+#ifndef __UVALUE_EXPR_H__
+#define __UVALUE_EXPR_H__
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Expression - base of the expression nodes. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             E is the node type.  A node folds into a single Unit Group when its Unit Values
+///             have one term each and its sums are of like units.  Otherwise it is evaluated
+///             with the operators of BasicUValue, so the result is always that of the same
+///             expression written without uvExpr.
+///             Nodes refer to the Unit Values of the expression, so an expression is meant to
+///             be assigned in the statement that builds it, not kept with auto. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T, typename E>
+class UExpr
+{
+public:
+    typedef T value_type;
+
+    const E& node(void) const { return static_cast<const E&>(*this); }
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Unit Value Expression evaluated into a Unit Value. </summary>
+    ///
+    /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+    ///-------------------------------------------------------------------------------------------------
+    BasicUValue<T> evaluate(void) const {
+        // folded straight into the term held inline by the result
+        BasicUValue<T> value;
+        value._units.push_back(BasicUnitGroup<T>());
+        if ( node().fold(value._units[0]) ) {
+            return value;
+        }
+
+        return node().eager();
+    }
+    operator BasicUValue<T>() const { return evaluate(); }
+};
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Expression leaf of a Unit Value. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+class UExprValue : public UExpr<T, UExprValue<T> >
+{
+private:
+    const BasicUValue<T> * _value;
+public:
+    explicit UExprValue(const BasicUValue<T>& value) : _value(&value) {}
+
+    // the term of a Unit Value of one term, used in place
+    const BasicUnitGroup<T> * term(void) const {
+        return ( _value->numberOfTerms() == 1 ) ? &_value->getUnits()[0] : nullptr;
+    }
+    bool fold(BasicUnitGroup<T>& group) const {
+        if ( _value->numberOfTerms() != 1 ) {
+            return false;
+        }
+        group = _value->getUnits()[0];
+        return true;
+    }
+    BasicUValue<T> eager(void) const { return *_value; }
+};
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Expression leaf of a unitless value. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+class UExprScalar : public UExpr<T, UExprScalar<T> >
+{
+private:
+    T _value;
+public:
+    explicit UExprScalar(T value) : _value(value) {}
+
+    const BasicUnitGroup<T> * term(void) const { return nullptr; }
+    bool fold(BasicUnitGroup<T>& group) const {
+        group = BasicUnitGroup<T>(_value);
+        return true;
+    }
+    BasicUValue<T> eager(void) const { return BasicUValue<T>(_value); }
+};
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Expression of a binary operator - '*', '/', '+' or '-'. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T, char Oper, typename L, typename R>
+class UExprBinary : public UExpr<T, UExprBinary<T, Oper, L, R> >
+{
+private:
+    L _left;
+    R _right;
+public:
+    UExprBinary(const L& left, const R& right) : _left(left), _right(right) {}
+
+    const BasicUnitGroup<T> * term(void) const { return nullptr; }
+    bool fold(BasicUnitGroup<T>& group) const {
+        if ( !_left.fold(group) ) {
+            return false;
+        }
+
+        // a Unit Value on the right is folded in as it is, anything else is folded first
+        BasicUnitGroup<T> folded;
+        const BasicUnitGroup<T> * right_term = _right.term();
+        if ( !right_term ) {
+            if ( !_right.fold(folded) ) {
+                return false;
+            }
+            right_term = &folded;
+        }
+        const BasicUnitGroup<T>& right = *right_term;
+
+        switch(Oper) {
+            case '*':
+                group *= right;
+                break;
+            case '/':
+                group /= right;
+                break;
+            case '+':
+            case '-':
+                // unlike units are a polynomial - left to BasicUValue
+                if ( group != right ) {
+                    return false;
+                }
+                if ( Oper == '+' ) {
+                    group += right;
+                }
+                else {
+                    group -= right;
+                }
+                break;
+        }
+
+        return true;
+    }
+    BasicUValue<T> eager(void) const {
+        switch(Oper) {
+            case '*':
+                return _left.eager()*_right.eager();
+            case '/':
+                return _left.eager()/_right.eager();
+            case '+':
+                return _left.eager() + _right.eager();
+            default:
+                return _left.eager() - _right.eager();
+        }
+    }
+};
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Expression of a Unit Value - the start of an expression. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+inline UExprValue<T> uvExpr(const BasicUValue<T>& value)
+{
+    return UExprValue<T>(value);
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Expression operators - an expression with an expression, a Unit Value
+///             or a unitless value. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+#define UEXPR_OPERATOR(op, oper_char)                                                           \
+template<typename T, typename L, typename R>                                                    \
+inline UExprBinary<T, oper_char, L, R> operator op(const UExpr<T, L>& left, const UExpr<T, R>& right) \
+{                                                                                               \
+    return UExprBinary<T, oper_char, L, R>(left.node(), right.node());                          \
+}                                                                                               \
+template<typename T, typename L>                                                                \
+inline UExprBinary<T, oper_char, L, UExprValue<T> >                                             \
+operator op(const UExpr<T, L>& left, const BasicUValue<T>& right)                               \
+{                                                                                               \
+    return UExprBinary<T, oper_char, L, UExprValue<T> >(left.node(), UExprValue<T>(right));     \
+}                                                                                               \
+template<typename T, typename R>                                                                \
+inline UExprBinary<T, oper_char, UExprValue<T>, R>                                              \
+operator op(const BasicUValue<T>& left, const UExpr<T, R>& right)                               \
+{                                                                                               \
+    return UExprBinary<T, oper_char, UExprValue<T>, R>(UExprValue<T>(left), right.node());      \
+}                                                                                               \
+template<typename T, typename L>                                                                \
+inline UExprBinary<T, oper_char, L, UExprScalar<T> >                                            \
+operator op(const UExpr<T, L>& left, typename UExpr<T, L>::value_type right)                    \
+{                                                                                               \
+    return UExprBinary<T, oper_char, L, UExprScalar<T> >(left.node(), UExprScalar<T>(right));   \
+}                                                                                               \
+template<typename T, typename R>                                                                \
+inline UExprBinary<T, oper_char, UExprScalar<T>, R>                                             \
+operator op(typename UExpr<T, R>::value_type left, const UExpr<T, R>& right)                    \
+{                                                                                               \
+    return UExprBinary<T, oper_char, UExprScalar<T>, R>(UExprScalar<T>(left), right.node());    \
+}
+
+UEXPR_OPERATOR(*, '*')
+UEXPR_OPERATOR(/, '/')
+UEXPR_OPERATOR(+, '+')
+UEXPR_OPERATOR(-, '-')
+
+#undef UEXPR_OPERATOR
+
+#endif // __UVALUE_EXPR_H__
@@ -17,8 +17,15 @@
 //              EnergyConversion - conversion engine for units of energy
 //              PowerConversion - conversion engine for units of power
 //              AngleConversion - conversion engine for angles
+//              AreaConversion - conversion engine for areas
 //
 //              foundInUnits - utility function for finding the units
+//              unitIndexInUnits - utility function for finding the index of a unit
+//              unit_classes - registry of the unit tables and their conversion engines
+//              unitIndexInClass - perfect hash lookup of a unit in a registered units table
+//              *ConversionPlan - conversion planners resolving a pair of units into a plan
+//              conversionPlan - cached plans of the registered unit classes
+//              *ConversionBulk - bulk conversion engines converting buffers of values
 //
 //
 //  Copyright (c) 2014 by Michael Ryan
@@ -28,33 +35,32 @@
 #include <sstream>
 #include <map>
 #include <list>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <math.h>
+#include <stdlib.h>
 #include "Conversions.h"
 
-#ifdef WIN32
-
-#define ISNAN(a)            _isnan(a)
-
-#else
-
-#define ISNAN(a)            isnan(a)
-
-#endif
-
-#ifdef UV_USE_LONG_DOUBLE
-#define POW(a,b)            powl(a,b)
-#else
-#define POW(a,b)            pow(a,b)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define UV_BULK_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define UV_BULK_SSE2
 #endif
 
 const char *const scalar[] = {""};
+const int scalar_len = sizeof(scalar)/sizeof(char *);
 
 // Does nothing except test for isnan
-bool IdentityConversion(double_uv& value_in,
-                        int in,
-                        int out,
-                        const double_uv * params_list,
-                        size_t params_list_len)
+bool IdentityConversion(engine_uv& value_in,
+                        [[maybe_unused]] int in,
+                        [[maybe_unused]] int out,
+                        [[maybe_unused]] const engine_uv * params_list,
+                        [[maybe_unused]] size_t params_list_len)
 {
 	return (!ISNAN(value_in));
 }
@@ -67,16 +73,16 @@ const int freqs_len = sizeof(freqs)/sizeof(char *);
 /*
  Frequency Conversion engine
  */
-bool FreqConversion(double_uv& value_in,
+bool FreqConversion(engine_uv& value_in,
                            int in,
                            int out,
-                           const double_uv * params_list,
-                           size_t params_list_len)
+                           [[maybe_unused]] const engine_uv * params_list,
+                           [[maybe_unused]] size_t params_list_len)
 {
     if ( in < 0 || out < 0 ) return false;
 
 	if ( in != out ) {
-		value_in = value_in*POW(10, 3*((double_uv)in-(double_uv)out));
+		value_in = value_in*POW(10, 3*((engine_uv)in-(engine_uv)out));
 	}
     
 	return (!ISNAN(value_in) );
@@ -89,133 +95,123 @@ bool FreqConversion(double_uv& value_in,
 const char *const ampls[] = {"dBm", "dBmV", "dBuV", "dBmA", "dBuA", "dB", "V", "W", "A", "mV", "mW", "mA", "dBµV", "dBµA"};
 const int ampls_len = sizeof(ampls)/sizeof(char *);
 
+/* "dBm", "dBmV", "dBuV", "dBmA", "dBuA", "dB", "V", "W", "A", "mV", "mW", "mA", "dBµV", "dBµA"*/
+typedef enum {
+    eUdBm = 0,
+    eUdBmV,
+    eUdBuV,
+    eUdBmA,
+    eUdBuA,
+    eUdB,
+    eUV,
+    eUW,
+    eUA,
+    eUmV,
+    eUmW,
+    eUmA,
+    eUdBmuV,
+    eUdBmuA
+} AmplUnits;
+
 /*
- Power Ratio Conversion engine
+ Every power ratio unit relative to dBm:
+    log units       dBm = value + offset + impedance_sign*10*log10(impedance)
+    linear units    dBm = log_scale*log10(value) + offset + impedance_sign*10*log10(impedance)
  */
+typedef struct {
+    bool linear;
+    engine_uv log_scale;
+    engine_uv offset;
+    int impedance_sign;
+} AmplUnitDef;
+
+static const AmplUnitDef ampl_defs[] = {
+    { false, 1, 0, 0 },         // dBm
+    { false, 1, -30, -1 },      // dBmV
+    { false, 1, -90, -1 },      // dBuV
+    { false, 1, -30, 1 },       // dBmA
+    { false, 1, -90, 1 },       // dBuA
+    { false, 1, 0, 0 },         // dB
+    { true, 20, 30, -1 },       // V
+    { true, 10, 30, 0 },        // W
+    { true, 20, 30, 1 },        // A
+    { true, 20, 0, -1 },        // mV
+    { true, 10, 0, 0 },         // mW
+    { true, 20, 0, 1 },         // mA
+    { false, 1, -90, -1 },      // dBµV
+    { false, 1, -90, 1 }        // dBµA
+};
+
+// default parameters of the power ratio units - impedance in Ohms
+static const engine_uv ampl_params[] = { 50 };
+static const int ampl_params_len = sizeof(ampl_params)/sizeof(engine_uv);
 
-bool AmplConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+/*
+ Power Ratio Conversion planner
+ */
+bool AmplConversionPlan(ConversionPlan& plan, [[maybe_unused]] UnitConversion conversion, int in, int out,
+                        const engine_uv * params_list, size_t params_list_len)
 {
-	double_uv impedance = 50; // Assuming 50 Ohms
+	engine_uv impedance = ampl_params[0];
+    const int defs_len = sizeof(ampl_defs)/sizeof(AmplUnitDef);
+
+    plan.kind = ePlanInvalid;
+    plan.scale = 1;
+    plan.offset = 0;
+    plan.power = 1;
+
+    if ( in < 0 || out < 0 || in >= defs_len || out >= defs_len ) return false;
+
+    if ( in == out ) {
+        plan.kind = ePlanIdentity;
+        return true;
+    }
 
-    if ( in < 0 || out < 0 ) return false;
-    
 	if ( params_list && params_list_len > 0 ) {
 		impedance = *params_list;
 	}
-    /* "dBm", "dBmV", "dBuV", "dBmA", "dBuA", "dB", "V", "W", "A", "mV", "mW", "mA", "dBµV", "dBµA"*/
-    typedef enum {
-        eUdBm = 0,
-        eUdBmV,
-        eUdBuV,
-        eUdBmA,
-        eUdBuA,
-        eUdB,
-        eUV,
-        eUW,
-        eUA,
-        eUmV,
-        eUmW,
-        eUmA,
-        eUdBmuV,
-        eUdBmuA
-    } AmplUnits;
-    
-	if ( in != out ) {
-		switch(in) {
-            case eUdBm: // dBm
-                break;
-            case eUdBmV: // dBmV
-                value_in = value_in - 10.0*log10(impedance) - 30.0;
-                break;
-            case eUdBmuV:
-            case eUdBuV: // dBuV
-                value_in = value_in-10.0*log10(impedance) - 90.0;
-                break;
-            case eUdBmA: // dBmA
-                value_in = value_in+10.0*log10(impedance) - 30.0;
-                break;
-            case eUdBmuA:
-            case eUdBuA: // dBuA
-                value_in = value_in+10.0*log10(impedance) - 90.0;
-                break;
-            case eUdB: // dB
-                break;
-            case eUmV: // mV
-            case eUV: // V
-                value_in = (20.0*log10(value_in))-(10*log10(impedance));
-                if ( in == eUV ) {
-                    value_in = value_in + 30.0;
-                }    
-                break;
-            case eUmW: // mW
-            case eUW: // W
-                value_in = 10.0*log10(value_in);
-                if ( in == eUW ) {
-                    value_in = value_in + 30;
-                }
-                break;
-            case eUmA: // mA
-            case eUA: // A
-                value_in = (20.0*log10(value_in)) + (10.0*log10(impedance));
-                if ( in == eUA ) {
-                    value_in = value_in + 30.0;
-                }
-                break;
-		}
-        
-		switch(out) {
-            case eUdBm: // dBm
-                break;
-            case eUdBmV: // dBmV
-                value_in = value_in + 10.0*log10(impedance) + 30.0;
-                break;
-            case eUdBmuV:
-            case eUdBuV: // dBuV
-                value_in = value_in + 10.0*log10(impedance) + 90.0;
-                break;
-            case eUdBmA: // dBmA
-                value_in = value_in - 10.0*log10(impedance) + 30.0;
-                break;
-            case eUdBmuA:
-            case eUdBuA: // dBuA
-                value_in = value_in - 10.0*log10(impedance) + 90.0;
-                break;
-            case eUdB: // dB
-                break;
-            case eUmV: // mV
-            case eUV: // V
-			{
-                double_uv conv = value_in + 10*log10(impedance);
-                if ( out == eUV ) {
-                    conv -= 30.0;
-                }
-                value_in = POW(10, conv/20);
-                break;
-			}
-            case eUmW: // mW
-            case eUW: // W
-			{
-                double_uv conv = (value_in/10);
-                if ( out == eUW ) {
-                    conv -= 3;
-                }
-                value_in = POW(10, conv);
-                break;
-			}
-            case eUmA: // mA
-            case eUA: // A
-			{
-                double_uv conv = (value_in - (10*log10(impedance)));
-                if ( out == eUA ) {
-                    conv -= 30;
-                }
-                value_in = POW(10, conv/20);
-                break;
-			}
-		}
-	}
-    
-	return (!ISNAN(value_in));
+
+    const engine_uv log_impedance = 10.0*LOG10(impedance);
+    const AmplUnitDef& def_in = ampl_defs[in];
+    const AmplUnitDef& def_out = ampl_defs[out];
+    // dBm(in) - dBm(out) apart from the values' own terms
+    const engine_uv offset = (def_in.offset + def_in.impedance_sign*log_impedance)
+                            - (def_out.offset + def_out.impedance_sign*log_impedance);
+
+    if ( !def_in.linear && !def_out.linear ) {
+        plan.kind = ePlanAffine;
+        plan.offset = offset;
+    }
+    else if ( def_in.linear && !def_out.linear ) {
+        plan.kind = ePlanToLog;
+        plan.scale = def_in.log_scale;
+        plan.offset = offset;
+    }
+    else if ( !def_in.linear && def_out.linear ) {
+        plan.kind = ePlanFromLog;
+        plan.scale = 1/def_out.log_scale;
+        plan.offset = offset/def_out.log_scale;
+    }
+    else {
+        plan.kind = ePlanPower;
+        plan.power = def_in.log_scale/def_out.log_scale;
+        plan.scale = POW(10, offset/def_out.log_scale);
+    }
+
+    return true;
+}
+
+/*
+ Power Ratio Conversion engine
+ */
+
+bool AmplConversion(engine_uv& value_in, int in, int out, const engine_uv * params_list, size_t params_list_len)
+{
+    ConversionPlan plan;
+
+    if ( !AmplConversionPlan(plan, AmplConversion, in, out, params_list, params_list_len) ) return false;
+
+    return applyConversionPlan(plan, value_in);
 }
 
 
@@ -227,20 +223,20 @@ const int times_len = sizeof(times)/sizeof(char *);
 /*
  Time Conversion engine
  */
-bool TimeConversion(double_uv& value_in,
+bool TimeConversion(engine_uv& value_in,
                            int in,
                            int out,
-                           const double_uv * params_list,
-                           size_t params_list_len)
+                           [[maybe_unused]] const engine_uv * params_list,
+                           [[maybe_unused]] size_t params_list_len)
 {
 	if ( in < 0 || out < 0 ) return false;
     
 	if ( in != out ) {
 		if ( in < 6 && out < 6 ) {
-            value_in = value_in*POW(10, 3.0*(((double_uv)in-(double_uv)out)));
+            value_in = value_in*POW(10, 3.0*(((engine_uv)in-(engine_uv)out)));
 		}
 		else {
-			double_uv factors[] = {1.0, 1.0};
+			engine_uv factors[] = {1.0, 1.0};
 			int indexes[] = { in, out };
             
 			for(int i = 0; i < 2; i++ ) {
@@ -252,11 +248,11 @@ bool TimeConversion(double_uv& value_in,
                     case 3:
                     case 4:
                     case 5:
-                        factors[i] = POW(10, 3.0*((double_uv)index-5.0));
+                        factors[i] = POW(10, 3.0*((engine_uv)index-5.0));
                         break;
                     case 6:
                     case 7:
-                        factors[i] = POW(60, (double_uv)index-5.0);
+                        factors[i] = POW(60, (engine_uv)index-5.0);
                         break;
                     case 8:
                         factors[i] = 86400.0;
@@ -271,7 +267,7 @@ bool TimeConversion(double_uv& value_in,
 				}
 			}
             
-			double_uv ratio = factors[0]/factors[1];
+			engine_uv ratio = factors[0]/factors[1];
 			value_in = ratio*value_in;
 		}
 	} // in != out
@@ -287,10 +283,10 @@ const int dists_len = sizeof(dists)/sizeof(char *);
 /*
  Distance Conversion engine
  */
-bool DistanceConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool DistanceConversion(engine_uv& value_in, int in, int out, [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
 {
 	const int startEnglish = 10;
-    const double_uv mfactors[] = {
+    const engine_uv mfactors[] = {
         1e-15, // fm
         1e-10, // Angstrom
         1e-9, // nm
@@ -323,7 +319,7 @@ bool DistanceConversion(double_uv& value_in, int in, int out, const double_uv *
         3.08567758e+16 // parsec
     };
     
-    const double_uv efactors[] = {
+    const engine_uv efactors[] = {
     	1/12000.0, //mil
 		1/768., // 1/64
 		1/384., // 1/32
@@ -342,14 +338,14 @@ bool DistanceConversion(double_uv& value_in, int in, int out, const double_uv *
 		6000., // geo mile
 		18228.3552 // league
     };
-    const int endEnglish = (sizeof(efactors)/sizeof(double_uv))+startEnglish-1;
+    const int endEnglish = (sizeof(efactors)/sizeof(engine_uv))+startEnglish-1;
 
-    int mfactors_len = sizeof(mfactors)/sizeof(double_uv);
+    int mfactors_len = sizeof(mfactors)/sizeof(engine_uv);
     
 	if ( in < 0 || out < 0 || in > mfactors_len || out > mfactors_len ) return false;
     
 	if ( in != out ) {
-		double_uv factor = 0;
+		engine_uv factor = 0;
 		if(in >= startEnglish && in <= endEnglish
 				&& out >= startEnglish && out <= endEnglish) {
 			factor = efactors[in-startEnglish]/efactors[out-startEnglish];
@@ -367,36 +363,53 @@ bool DistanceConversion(double_uv& value_in, int in, int out, const double_uv *
 const char *const temps_units[] = {"K", "F", "C"};
 const int temps_units_len = sizeof(temps_units)/sizeof(char *);
 
+/*
+ Temp Conversion planner - every unit as Celsius = scale*value + offset
+ */
+bool TempConversionPlan(ConversionPlan& plan, [[maybe_unused]] UnitConversion conversion, int in, int out,
+                        [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
+{
+    const engine_uv scales[] = {
+        1.0, // Kelvin
+        5.0/9.0, // Fahrenheit
+        1.0 // Celsius
+    };
+    const engine_uv offsets[] = {
+        -273.15, // Kelvin
+        -32.0*5.0/9.0, // Fahrenheit
+        0 // Celsius
+    };
+    const int scales_len = sizeof(scales)/sizeof(engine_uv);
+
+    plan.kind = ePlanInvalid;
+    plan.scale = 1;
+    plan.offset = 0;
+    plan.power = 1;
+
+    if ( in < 0 || out < 0 || in >= scales_len || out >= scales_len ) return false;
+
+    if ( in == out ) {
+        plan.kind = ePlanIdentity;
+    }
+    else {
+        plan.kind = ePlanAffine;
+        plan.scale = scales[in]/scales[out];
+        plan.offset = (offsets[in] - offsets[out])/scales[out];
+    }
+
+    return true;
+}
+
 /*
  Temp Conversion engine
  */
-bool TempConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool TempConversion(engine_uv& value_in, int in, int out, const engine_uv * params_list, size_t params_list_len)
 {
-	if ( in != out ) {
-		switch(in) {
-            case 0: // Kelvin
-                value_in -= 273.15;
-                break;
-            case 1: // Fahrenheit
-                value_in = (value_in - 32)*(5.0/9.0);
-                break;
-            case 2: // Celsius
-                break;
-		}
-        
-		switch(out) {
-            case 0: // Kelvin
-                value_in += 273.15;
-                break;
-            case 1: // Fahrenheit
-                value_in = ((value_in)*9.0/5.0) + 32;
-                break;
-            case 2: // Celsius
-                break;
-		}
-	}
-    
-	return !(ISNAN(value_in));
+    ConversionPlan plan;
+
+    if ( !TempConversionPlan(plan, TempConversion, in, out, params_list, params_list_len) ) return false;
+
+    return applyConversionPlan(plan, value_in);
 }
 
 /* Current Units */
@@ -407,13 +420,13 @@ const int currents_len = sizeof(currents)/sizeof(char *);
  Current Conversion engine
  */
 
-bool CurrentConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool CurrentConversion(engine_uv& value_in, int in, int out, [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
 {
-	double_uv in_factor = 0;
-	double_uv out_factor = 0;
+	engine_uv in_factor = 0;
+	engine_uv out_factor = 0;
     // nA, uA, mA, A, C/s, kA
-	const double_uv factors[] = {-9, -6, -3, 0, 0, 3};
-    int factors_len = sizeof(factors)/sizeof(double_uv);
+	const engine_uv factors[] = {-9, -6, -3, 0, 0, 3};
+    int factors_len = sizeof(factors)/sizeof(engine_uv);
     
 	if ( in != out ) {
 		if ( in >= 0 && in < factors_len ) {
@@ -443,12 +456,12 @@ const int volumes_len = sizeof(volumes)/sizeof(char *);
  Volume Conversion engine
  */
 
-bool VolumeConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool VolumeConversion(engine_uv& value_in, int in, int out, [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
 {
-	double_uv in_factor = 0;
-	double_uv out_factor = 0;
+	engine_uv in_factor = 0;
+	engine_uv out_factor = 0;
     
-	const double_uv factors[] = {
+	const engine_uv factors[] = {
         .000001, // ml
         .000001, //cm^3
         .001, // l
@@ -500,7 +513,7 @@ bool VolumeConversion(double_uv& value_in, int in, int out, const double_uv * pa
         3.5239e-2 // bushel
     };
 
-    const double_uv en_factors[] = {
+    const engine_uv en_factors[] = {
         64., //dram
         48., // tsp
         16., // tbsp
@@ -516,7 +529,7 @@ bool VolumeConversion(double_uv& value_in, int in, int out, const double_uv * pa
     const int en_us_factors_offset = 11;
     const int en_uk_factors_offset = 23;
 
-    int factors_len = sizeof(factors)/sizeof(double_uv);
+    int factors_len = sizeof(factors)/sizeof(engine_uv);
 
     if( in >= en_us_factors_offset && in <= 20 && out >= en_us_factors_offset && out <= 20 )
     {
@@ -552,12 +565,12 @@ const int masses_len = sizeof(masses)/sizeof(char *);
  Mass Conversion engine
  */
 
-bool MassConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool MassConversion(engine_uv& value_in, int in, int out, [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
 {
-	double_uv in_factor = 0;
-	double_uv out_factor = 0;
+	engine_uv in_factor = 0;
+	engine_uv out_factor = 0;
     /* "mg", "g", "kg", "Mg", "t", "lb", "troy", "gr", "scruple", "pennyweight", "dram", "oz", "troy oz", "carat", "stone", "slug", "hundredweight", "ton", "long ton"*/
-	const double_uv factors[] = {
+	const engine_uv factors[] = {
         .001, // mg
         1, //g
         1000, // kg
@@ -580,7 +593,7 @@ bool MassConversion(double_uv& value_in, int in, int out, const double_uv * para
         
     };
     
-    int factors_len = sizeof(factors)/sizeof(double_uv);
+    int factors_len = sizeof(factors)/sizeof(engine_uv);
     
 	if ( in != out ) {
 		if ( in >= 0 && in < factors_len ) {
@@ -605,13 +618,13 @@ const int forces_len = sizeof(forces)/sizeof(char *);
  Force Conversion engine
  */
 
-bool ForceConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool ForceConversion(engine_uv& value_in, int in, int out, [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
 {
-	double_uv in_factor = 0;
-	double_uv out_factor = 0;
+	engine_uv in_factor = 0;
+	engine_uv out_factor = 0;
     /* "dyne", "N", "kg*m/s^2", "ozf", "lbf", "gmf", "kgf", "kip", "ton-force"*/
-	const double_uv factors[] = {1e-5, 1, 1, .27801, 4.4482, 9806.65, 9.80665, 4448.2, 8896.4};
-    int factors_len = sizeof(factors)/sizeof(double_uv);
+	const engine_uv factors[] = {1e-5, 1, 1, .27801, 4.4482, 9806.65, 9.80665, 4448.2, 8896.4};
+    int factors_len = sizeof(factors)/sizeof(engine_uv);
     
 	if ( in != out ) {
 		if ( in >= 0 && in < factors_len ) {
@@ -637,12 +650,12 @@ const int pressures_len = sizeof(pressures)/sizeof(char *);
  Pressure Conversion engine
  */
 
-bool PressureConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool PressureConversion(engine_uv& value_in, int in, int out, [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
 {
-	double_uv in_factor = 0;
-	double_uv out_factor = 0;
+	engine_uv in_factor = 0;
+	engine_uv out_factor = 0;
 
-	const double_uv factors[] = {
+	const engine_uv factors[] = {
         .1, // dyne/cm^2
         1, // Pa
         133.3224, // torr
@@ -660,7 +673,7 @@ bool PressureConversion(double_uv& value_in, int in, int out, const double_uv *
         6894.8, // lbf/in^2
         98066.5 // kgf/cm^2
     };
-    int factors_len = sizeof(factors)/sizeof(double_uv);
+    int factors_len = sizeof(factors)/sizeof(engine_uv);
     
 	if ( in != out ) {
 		if ( in >= 0 && in < factors_len ) {
@@ -686,12 +699,12 @@ const int energies_len = sizeof(energies)/sizeof(char *);
  Energy Conversion engine
  */
 
-bool EnergyConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool EnergyConversion(engine_uv& value_in, int in, int out, [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
 {
-	double_uv in_factor = 0;
-	double_uv out_factor = 0;
+	engine_uv in_factor = 0;
+	engine_uv out_factor = 0;
     
-	const double_uv factors[] = {
+	const engine_uv factors[] = {
         1e-7, // erg
         4.184e+9, // ton TNT
 		.001, // mJ
@@ -711,7 +724,7 @@ bool EnergyConversion(double_uv& value_in, int in, int out, const double_uv * pa
         1055.05585262, // Btu ST
         1e+18 // quad
     };
-    int factors_len = sizeof(factors)/sizeof(double_uv);
+    int factors_len = sizeof(factors)/sizeof(engine_uv);
     
 	if ( in != out ) {
 		if ( in >= 0 && in < factors_len ) {
@@ -736,12 +749,12 @@ const int powers_len = sizeof(powers)/sizeof(char *);
  Power Conversion engine
  */
 
-bool PowerConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool PowerConversion(engine_uv& value_in, int in, int out, [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
 {
-	double_uv in_factor = 0;
-	double_uv out_factor = 0;
+	engine_uv in_factor = 0;
+	engine_uv out_factor = 0;
     
-	const double_uv factors[] = {
+	const engine_uv factors[] = {
         4.1868, // cal/s
         4.184, // cal th/s
         1e-7, // erg/s
@@ -756,7 +769,7 @@ bool PowerConversion(double_uv& value_in, int in, int out, const double_uv * par
         745.70, // hp
         746 // electric hp
     };
-    int factors_len = sizeof(factors)/sizeof(double_uv);
+    int factors_len = sizeof(factors)/sizeof(engine_uv);
     
 	if ( in != out ) {
 		if ( in >= 0 && in < factors_len ) {
@@ -781,12 +794,12 @@ const int angles_len = sizeof(angles)/sizeof(char *);
  Angle Conversion Engine
  */
 
-bool AngleConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool AngleConversion(engine_uv& value_in, int in, int out, [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
 {
-    double_uv in_factor = 0;
-    double_uv out_factor = 0;
+    engine_uv in_factor = 0;
+    engine_uv out_factor = 0;
     
-    const double_uv factors[] = {
+    const engine_uv factors[] = {
     	1/6400.0, // mil
         1.0, // °
         1.0, // deg
@@ -799,7 +812,7 @@ bool AngleConversion(double_uv& value_in, int in, int out, const double_uv * par
         90./100. // grad
     };
     
-    int factors_len = sizeof(factors)/sizeof(double_uv);
+    int factors_len = sizeof(factors)/sizeof(engine_uv);
 
     if ( in >= factors_len || out >= factors_len ) return 0;
 
@@ -824,13 +837,13 @@ const int areas_len = sizeof(areas)/sizeof(char *);
 
 /* Area Conversion Engine */
 
-bool AreaConversion(double_uv& value_in, int in, int out, const double_uv * params_list, size_t params_list_len)
+bool AreaConversion(engine_uv& value_in, int in, int out, [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
 {
-    double_uv in_factor = 0;
-    double_uv out_factor = 0;
-    double_uv factor = 1.0;
+    engine_uv in_factor = 0;
+    engine_uv out_factor = 0;
+    engine_uv factor = 1.0;
     
-    const double_uv factors[] = {
+    const engine_uv factors[] = {
         1e-46, // ab
         1e-43,// fb
         1e-40, // pb
@@ -860,7 +873,7 @@ bool AreaConversion(double_uv& value_in, int in, int out, const double_uv * para
     };
 
     // reference square ft
-    const double_uv en_factors[] = {
+    const engine_uv en_factors[] = {
         (1./(144.))*0.000001,// sq mil
         1./144.,// sq in
         1, // sq ft
@@ -873,7 +886,7 @@ bool AreaConversion(double_uv& value_in, int in, int out, const double_uv * para
         1003618598.4036, // survey township
     };
      
-    int factors_len = sizeof(factors)/sizeof(double_uv);
+    int factors_len = sizeof(factors)/sizeof(engine_uv);
 
     const int en_factors_start = 16;
     const int en_factors_end = 25;
@@ -917,16 +930,1103 @@ bool AreaConversion(double_uv& value_in, int in, int out, const double_uv * para
 
 bool foundUnitInUnits(const char * pUnit, const char *const* units, const int units_len)
 {
-    bool bFound = false;
-    
+    return ( pUnit && unitIndexInUnits(std::string_view(pUnit), units, units_len) >= 0 );
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	unitIndexInUnits - Searches units for pUnit </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         pUnit - unit string to check
+///         units - array of allowable units
+///         units_len - number of allowable units
+/// </parameters>
+/// <returns>   index of pUnit in units or -1 if not found </returns>
+///-------------------------------------------------------------------------------------------------
+
+int unitIndexInUnits(const char * pUnit, const char *const* units, const int units_len)
+{
+    if ( !pUnit ) {
+        return -1;
+    }
+
+    return unitIndexInUnits(std::string_view(pUnit), units, units_len);
+}
+
+int unitIndexInUnits(std::string_view unit, const char *const* units, const int units_len)
+{
+    int unit_class = unitClassOfUnits(units);
+
+    if ( unit_class >= 0 ) {
+        return unitIndexInClass(unit_class, unit);
+    }
+
+    // not a registered table - search it
     for(int i = 0; i < units_len; i++)
     {
-        if ( STRCMP(*(units+i), pUnit) == 0 )
+        const char * candidate = *(units+i);
+        if ( STRNCMP(candidate, unit.data(), unit.size()) == 0 && candidate[unit.size()] == '\0' )
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// bulk engines of a unit class for each precision
+#define UNIT_BULK_CONVERSIONS(bulk)     bulk<float>, bulk<double>, bulk<long double>
+
+/* Unit Classes */
+const UnitClassInfo unit_classes[eUnitClassCount] = {
+    { scalar, scalar_len, IdentityConversion, IdentityConversionPlan, UNIT_BULK_CONVERSIONS(IdentityConversionBulk),
+      "Scalar", 0, nullptr, 0, eEngineLinear, UNIT_DIMENSION(0, 0, 0, 0, 0), 0 },                         // eUnitScalar
+    { freqs, freqs_len, FreqConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(FreqConversionBulk),
+      "Frequency", 2, nullptr, 0, eEngineLinear, UNIT_DIMENSION(0, 0, -1, 0, 0), 0 },                     // eUnitFrequency
+    { ampls, ampls_len, AmplConversion, AmplConversionPlan, UNIT_BULK_CONVERSIONS(AmplConversionBulk),
+      "Ampl", eUdBm, ampl_params, ampl_params_len, eEngineLog, UNIT_DIMENSION(0, 0, 0, 0, 0), eUdBm },    // eUnitAmpl
+    { times, times_len, TimeConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(TimeConversionBulk),
+      "Time", 5, nullptr, 0, eEngineLinear, UNIT_DIMENSION(0, 0, 1, 0, 0), 5 },                           // eUnitTime
+    { dists, dists_len, DistanceConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(DistanceConversionBulk),
+      "Dist", 7, nullptr, 0, eEngineLinear, UNIT_DIMENSION(0, 1, 0, 0, 0), 7 },                           // eUnitDist
+    { temps_units, temps_units_len, TempConversion, TempConversionPlan, UNIT_BULK_CONVERSIONS(TempConversionBulk),
+      "Temp", 2, nullptr, 0, eEngineAffine, UNIT_DIMENSION(0, 0, 0, 0, 1), 0 },                           // eUnitTemp
+    { currents, currents_len, CurrentConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(CurrentConversionBulk),
+      "Current", 3, nullptr, 0, eEngineLinear, UNIT_DIMENSION(0, 0, 0, 1, 0), 3 },                        // eUnitCurrent
+    { volumes, volumes_len, VolumeConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(VolumeConversionBulk),
+      "Volume", 2, nullptr, 0, eEngineLinear, UNIT_DIMENSION(0, 3, 0, 0, 0), 3 },                         // eUnitVolume
+    { masses, masses_len, MassConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(MassConversionBulk),
+      "Mass", 1, nullptr, 0, eEngineLinear, UNIT_DIMENSION(1, 0, 0, 0, 0), 2 },                           // eUnitMass
+    { forces, forces_len, ForceConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(ForceConversionBulk),
+      "Force", 1, nullptr, 0, eEngineLinear, UNIT_DIMENSION(1, 1, -2, 0, 0), 1 },                         // eUnitForce
+    { pressures, pressures_len, PressureConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(PressureConversionBulk),
+      "Pressure", 1, nullptr, 0, eEngineLinear, UNIT_DIMENSION(1, -1, -2, 0, 0), 1 },                     // eUnitPressure
+    { energies, energies_len, EnergyConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(EnergyConversionBulk),
+      "Energy", 3, nullptr, 0, eEngineLinear, UNIT_DIMENSION(1, 2, -2, 0, 0), 3 },                        // eUnitEnergy
+    { powers, powers_len, PowerConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(PowerConversionBulk),
+      "Power", 7, nullptr, 0, eEngineLinear, UNIT_DIMENSION(1, 2, -3, 0, 0), 7 },                         // eUnitPower
+    { angles, angles_len, AngleConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(AngleConversionBulk),
+      "Angle", 2, nullptr, 0, eEngineLinear, UNIT_DIMENSION(0, 0, 0, 0, 0), 8 },                          // eUnitAngle
+    { areas, areas_len, AreaConversion, ScaleConversionPlan, UNIT_BULK_CONVERSIONS(AreaConversionBulk),
+      "Area", 12, nullptr, 0, eEngineLinear, UNIT_DIMENSION(0, 2, 0, 0, 0), 12 }                          // eUnitArea
+};
+
+/*
+ Returns the UnitClassId that owns the units table, or -1 if none does
+ */
+int unitClassOfUnits(const char *const* units)
+{
+    for(int i = 0; i < eUnitClassCount; i++)
+    {
+        if ( unit_classes[i].units == units )
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+ Bit mask of the unit classes matched by dimension
+ */
+unsigned int dimensionalClassMask(void)
+{
+    static const unsigned int mask = []() {
+        unsigned int classes = 0;
+        for(int i = 0; i < eUnitClassCount; i++)
+        {
+            const UnitClassInfo& info = unit_classes[i];
+            bool has_dimension = false;
+            for(int d = 0; d < eDimCount; d++) {
+                has_dimension |= ( info.dimension[d] != 0 );
+            }
+            if ( has_dimension && info.engine_kind == eEngineLinear ) {
+                classes |= (1u << i);
+            }
+        }
+        return classes;
+    }();
+
+    return mask;
+}
+
+/*
+ Factor from a unit of a class raised to exponent to the SI unit of the class
+ */
+engine_uv dimensionFactor(int unit_class, int unit_index, double exponent)
+{
+    ConversionPlan plan;
+
+    if ( unit_class < 0 || unit_class >= eUnitClassCount
+         || !(dimensionalClassMask() & (1u << unit_class))
+         || !makeExponentPlan(plan, unit_class, unit_index, unit_classes[unit_class].si_unit, exponent) ) {
+        return NAN;
+    }
+
+    return ( plan.kind == ePlanIdentity ) ? 1 : plan.scale;
+}
+
+// slots of the derived unit index (a power of 2 over twice the unit classes)
+#define DIMENSION_INDEX_SLOTS       32
+
+typedef struct {
+    long long key[DIMENSION_INDEX_SLOTS];
+    int unit_class[DIMENSION_INDEX_SLOTS];     // -1 for an empty slot
+} DimensionIndex;
+
+static inline int dimensionSlot(long long key)
+{
+    return (int)((((unsigned long long)key*0x9E3779B97F4A7C15ULL) >> 32) & (DIMENSION_INDEX_SLOTS - 1));
+}
+
+/*
+ Unit class of a dimension key from an index hashed once from the registry
+ */
+int unitClassOfDimension(long long dimension_key)
+{
+    static const DimensionIndex index = []() {
+        DimensionIndex table;
+        for(int slot = 0; slot < DIMENSION_INDEX_SLOTS; slot++) {
+            table.unit_class[slot] = -1;
+        }
+        for(int i = 0; i < eUnitClassCount; i++)
+        {
+            if ( dimensionalClassMask() & (1u << i) ) {
+                int slot = dimensionSlot(unit_classes[i].dimension_key);
+                while ( table.unit_class[slot] != -1 ) {
+                    slot = (slot + 1) & (DIMENSION_INDEX_SLOTS - 1);
+                }
+                table.key[slot] = unit_classes[i].dimension_key;
+                table.unit_class[slot] = i;
+            }
+        }
+        return table;
+    }();
+
+    for(int slot = dimensionSlot(dimension_key); index.unit_class[slot] != -1; slot = (slot + 1) & (DIMENSION_INDEX_SLOTS - 1))
+    {
+        if ( index.key[slot] == dimension_key ) {
+            return index.unit_class[slot];
+        }
+    }
+
+    return -1;
+}
+
+/*
+ Route to unit_class - a whole power of its dimensions, or else the class once with the rest
+ of the dimensions in the class that has them (or the inverse of that class)
+ */
+static bool resolveCrossClassRoute(long long dimension_key, int unit_class, CrossClassRoute& route)
+{
+    const long long class_key = unit_classes[unit_class].dimension_key;
+
+    route.unit_class = unit_class;
+    route.rest_class = -1;
+    route.rest_exponent = 0;
+    // dimension keys pack linearly, so a power of the class is a multiple of its key
+    for(int power = 1; power <= CROSS_CLASS_MAX_EXPONENT; power++)
+    {
+        for(int sign = 1; sign >= -1; sign -= 2)
         {
-            bFound = true;
+            if ( (long long)(sign*power)*class_key == dimension_key ) {
+                route.exponent = sign*power;
+                return true;
+            }
+        }
+    }
+
+    const long long rest_key = dimension_key - class_key;
+    route.exponent = 1;
+    route.rest_class = unitClassOfDimension(rest_key);
+    route.rest_exponent = 1;
+    if ( route.rest_class == -1 ) {
+        route.rest_class = unitClassOfDimension(-rest_key);
+        route.rest_exponent = -1;
+    }
+
+    return ( route.rest_class != -1 );
+}
+
+/*
+ Cached routes across unit classes
+ */
+bool crossClassRoute(long long dimension_key, int unit_class, CrossClassRoute& route)
+{
+    static std::mutex routes_lock;
+    static std::map<std::pair<long long, int>, CrossClassRoute> routes;
+
+    if ( unit_class < 0 || unit_class >= eUnitClassCount || !(dimensionalClassMask() & (1u << unit_class))
+         || dimension_key == 0 ) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(routes_lock);
+    std::map<std::pair<long long, int>, CrossClassRoute>::iterator found
+        = routes.find(std::make_pair(dimension_key, unit_class));
+    if ( found == routes.end() ) {
+        CrossClassRoute resolved;
+        if ( !resolveCrossClassRoute(dimension_key, unit_class, resolved) ) {
+            resolved.unit_class = -1;
+        }
+        found = routes.insert(std::make_pair(std::make_pair(dimension_key, unit_class), resolved)).first;
+    }
+    route = found->second;
+
+    return ( route.unit_class != -1 );
+}
+
+/*
+ Unit targets - the classes with a unit abbrev. and the index of the unit in each
+ */
+static unsigned int classesOfUnit(std::string_view unit, short index[eUnitClassCount])
+{
+    unsigned int classes = 0;
+
+    for(int i = 0; i < eUnitClassCount; i++)
+    {
+        index[i] = (short)unitIndexInClass(i, unit);
+        if ( index[i] >= 0 ) {
+            classes |= (1u << i);
+        }
+    }
+
+    return classes;
+}
+
+static std::string_view trimUnit(std::string_view unit)
+{
+    while ( unit.size() && unit.front() == ' ' ) {
+        unit.remove_prefix(1);
+    }
+    while ( unit.size() && unit.back() == ' ' ) {
+        unit.remove_suffix(1);
+    }
+
+    return unit;
+}
+
+static bool parseTargetExponent(std::string_view text, double& exponent)
+{
+    char buffer[32];
+    char * end = nullptr;
+
+    text = trimUnit(text);
+    if ( text.empty() || text.size() >= sizeof(buffer) ) {
+        return false;
+    }
+    memcpy(buffer, text.data(), text.size());
+    buffer[text.size()] = '\0';
+    exponent = strtod(buffer, &end);
+
+    return ( end == buffer + text.size() && exponent != 0 && exponent == exponent
+             && exponent < HUGE_VAL && exponent > -HUGE_VAL );
+}
+
+/*
+ Unit target parser - expression := ('1' | term) (('*' | '/') term)*, term := (unit | '('
+ expression ')') ['^' exponent].  A unit is the longest abbrev. of a class that ends before an
+ operator, so abbrevs. with spaces or operators in them (i.e. "1/64 in", "kg*m/s^2") are found
+ whole.  A '1' before a '/' that is not part of an abbrev. is an empty numerator, as the units
+ print (i.e. "1/(s)").
+ */
+static UnitTargetError parseTargetExpression(std::string_view units, size_t& pos, double sign,
+                                             UnitTarget& target, int depth);
+
+static void skipSpaces(std::string_view units, size_t& pos)
+{
+    while ( pos < units.size() && units[pos] == ' ' ) {
+        pos++;
+    }
+}
+
+static bool parseEmptyNumerator(std::string_view units, size_t& pos)
+{
+    size_t next = pos;
+    skipSpaces(units, next);
+    if ( next == units.size() || units[next] != '1' ) {
+        return false;
+    }
+    next++;
+    skipSpaces(units, next);
+    if ( next == units.size() || units[next] != '/' ) {
+        return false;
+    }
+    pos = next;
+
+    return true;
+}
+
+static UnitTargetError parseTargetPower(std::string_view units, size_t& pos, double& exponent)
+{
+    exponent = 1;
+    skipSpaces(units, pos);
+    if ( pos == units.size() || units[pos] != '^' ) {
+        return eTargetOk;
+    }
+
+    size_t start = ++pos;
+    skipSpaces(units, pos);
+    if ( pos < units.size() && (units[pos] == '-' || units[pos] == '+') ) {
+        pos++;
+    }
+    while ( pos < units.size() && ((units[pos] >= '0' && units[pos] <= '9') || units[pos] == '.') ) {
+        pos++;
+    }
+
+    return parseTargetExponent(units.substr(start, pos - start), exponent) ? eTargetOk : eTargetSyntax;
+}
+
+static UnitTargetError parseTargetUnit(std::string_view units, size_t& pos, double sign, UnitTarget& target)
+{
+    // no abbrev. has parentheses in it
+    size_t limit = units.find_first_of("()", pos);
+    if ( limit == std::string_view::npos ) {
+        limit = units.size();
+    }
+
+    if ( pos == limit || strchr("*/^", units[pos]) ) {
+        // an operator with no unit before it
+        return eTargetSyntax;
+    }
+    if ( target.factors_len == UNIT_TARGET_MAX_FACTORS ) {
+        return eTargetTooManyUnits;
+    }
+    UnitTargetFactor& factor = target.factors[target.factors_len];
+    for(size_t end = limit; end > pos; end--)
+    {
+        if ( end < limit && !strchr("*/^", units[end]) ) {
+            continue;
+        }
+        std::string_view unit = trimUnit(units.substr(pos, end - pos));
+        if ( unit.size() && (factor.classes = classesOfUnit(unit, factor.index)) ) {
+            double exponent;
+            pos = end;
+            UnitTargetError ret = parseTargetPower(units, pos, exponent);
+            factor.exponent = sign*exponent;
+            target.factors_len++;
+            return ret;
+        }
+    }
+
+    return eTargetUnknownUnit;
+}
+
+static UnitTargetError parseTargetTerm(std::string_view units, size_t& pos, double sign,
+                                       UnitTarget& target, int depth)
+{
+    skipSpaces(units, pos);
+    if ( pos == units.size() || units[pos] != '(' ) {
+        return parseTargetUnit(units, pos, sign, target);
+    }
+
+    // a group, raised to its exponent as a whole
+    const int first = target.factors_len;
+    pos++;
+    UnitTargetError ret = parseTargetExpression(units, pos, sign, target, depth + 1);
+    if ( ret != eTargetOk ) {
+        return ret;
+    }
+    skipSpaces(units, pos);
+    if ( pos == units.size() || units[pos] != ')' ) {
+        return eTargetSyntax;
+    }
+    pos++;
+
+    double exponent;
+    ret = parseTargetPower(units, pos, exponent);
+    for(int i = first; i < target.factors_len; i++) {
+        target.factors[i].exponent *= exponent;
+    }
+
+    return ret;
+}
+
+static UnitTargetError parseTargetExpression(std::string_view units, size_t& pos, double sign,
+                                             UnitTarget& target, int depth)
+{
+    if ( depth > UNIT_TARGET_MAX_FACTORS ) {
+        return eTargetSyntax;
+    }
+
+    size_t start = pos;
+    UnitTargetError ret = parseTargetTerm(units, pos, sign, target, depth);
+    if ( ret == eTargetUnknownUnit && parseEmptyNumerator(units, start) ) {
+        pos = start;
+        ret = eTargetOk;
+    }
+    while ( ret == eTargetOk )
+    {
+        skipSpaces(units, pos);
+        if ( pos == units.size() || (units[pos] != '*' && units[pos] != '/') ) {
             break;
         }
+        double term_sign = ( units[pos] == '/' ) ? -sign : sign;
+        pos++;
+        ret = parseTargetTerm(units, pos, term_sign, target, depth);
     }
-    
-    return bFound;
+
+    return ret;
+}
+
+UnitTargetError parseUnitTarget(std::string_view units, UnitTarget& target)
+{
+    size_t pos = 0;
+
+    target.factors_len = 0;
+    if ( trimUnit(units).empty() ) {
+        return eTargetEmpty;
+    }
+
+    UnitTargetError ret = parseTargetExpression(units, pos, 1, target, 0);
+    skipSpaces(units, pos);
+    if ( ret == eTargetOk && pos != units.size() ) {
+        // i.e. an unmatched ')'
+        ret = eTargetSyntax;
+    }
+
+    return ret;
 }
+
+/*
+ Cache of parsed unit targets keyed on the exact string.  The keys are views of strings the
+ cache owns, and the entries of an unordered_map keep their address as it grows.
+ */
+typedef struct {
+    UnitTargetError error;
+    UnitTarget target;
+} CachedUnitTarget;
+
+UnitTargetError cachedUnitTarget(std::string_view units, const UnitTarget *& target, UnitTarget& scratch)
+{
+    static std::shared_mutex cache_lock;
+    static std::unordered_map<std::string_view, CachedUnitTarget> cache;
+    static std::list<std::string> keys;
+
+    {
+        std::shared_lock<std::shared_mutex> guard(cache_lock);
+        std::unordered_map<std::string_view, CachedUnitTarget>::const_iterator found = cache.find(units);
+        if ( found != cache.end() ) {
+            target = &found->second.target;
+            return found->second.error;
+        }
+    }
+
+    CachedUnitTarget parsed;
+    parsed.error = parseUnitTarget(units, parsed.target);
+
+    std::unique_lock<std::shared_mutex> guard(cache_lock);
+    std::unordered_map<std::string_view, CachedUnitTarget>::const_iterator found = cache.find(units);
+    if ( found == cache.end() ) {
+        if ( cache.size() >= UNIT_TARGET_CACHE_MAX ) {
+            scratch = parsed.target;
+            target = &scratch;
+            return parsed.error;
+        }
+        keys.emplace_back(units);
+        found = cache.emplace(std::string_view(keys.back()), parsed).first;
+    }
+    target = &found->second.target;
+
+    return found->second.error;
+}
+
+/*
+ Portable ASCII case-insensitive compares
+ */
+static inline unsigned char foldCase(unsigned char c)
+{
+    return ( c >= 'A' && c <= 'Z' ) ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+int uv_strnicmp(const char * a, const char * b, size_t n)
+{
+    for(size_t i = 0; i < n; i++)
+    {
+        unsigned char ca = foldCase((unsigned char)a[i]);
+        unsigned char cb = foldCase((unsigned char)b[i]);
+        if ( ca != cb || ca == '\0' ) {
+            return (int)ca - (int)cb;
+        }
+    }
+
+    return 0;
+}
+
+int uv_stricmp(const char * a, const char * b)
+{
+    return uv_strnicmp(a, b, (size_t)-1);
+}
+
+/*
+ Unit abbrev. perfect hashes - for every registered units table a seed is searched for
+ that sends each abbrev. to its own bucket.  They are built once on first use, so a
+ lookup is one hash and one compare.  The case folded hashes keep the first of any
+ abbrevs. that differ only by case (i.e. "mg" and "Mg") as a linear search would.
+ */
+#define UNITS_HASH_MAX_BUCKETS      256
+#define UNITS_HASH_MAX_SEEDS        100000
+
+typedef struct {
+    unsigned int seed;          // 0 - no perfect seed found, search the table instead
+    unsigned int mask;
+    short buckets[UNITS_HASH_MAX_BUCKETS];
+} UnitsHash;
+
+typedef struct {
+    UnitsHash exact[eUnitClassCount];
+    UnitsHash folded[eUnitClassCount];
+} UnitsHashes;
+
+static inline unsigned int hashUnit(std::string_view unit, unsigned int seed, bool fold_case)
+{
+    unsigned int h = 2166136261u ^ seed;
+
+    for(size_t i = 0; i < unit.size(); i++)
+    {
+        unsigned char c = (unsigned char)unit[i];
+        h ^= fold_case ? foldCase(c) : c;
+        h *= 16777619u;
+    }
+
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+
+    return h;
+}
+
+static inline bool equalUnit(std::string_view unit, const char * candidate, bool fold_case)
+{
+    if ( fold_case ) {
+        return uv_strnicmp(candidate, unit.data(), unit.size()) == 0 && candidate[unit.size()] == '\0';
+    }
+
+    return strncmp(candidate, unit.data(), unit.size()) == 0 && candidate[unit.size()] == '\0';
+}
+
+static void buildUnitsHash(UnitsHash& hash, const char *const* units, int units_len, bool fold_case)
+{
+    unsigned int buckets = 4;
+    while ( buckets < 4*(unsigned int)units_len && buckets < UNITS_HASH_MAX_BUCKETS ) {
+        buckets <<= 1;
+    }
+
+    hash.mask = buckets - 1;
+    hash.seed = 0;
+
+    for(unsigned int seed = 1; seed <= UNITS_HASH_MAX_SEEDS && hash.seed == 0; seed++)
+    {
+        bool perfect = true;
+
+        for(unsigned int b = 0; b < buckets; b++) {
+            hash.buckets[b] = -1;
+        }
+
+        for(int i = 0; i < units_len && perfect; i++)
+        {
+            std::string_view unit(units[i]);
+            short& bucket = hash.buckets[hashUnit(unit, seed, fold_case) & hash.mask];
+
+            if ( bucket < 0 ) {
+                bucket = (short)i;
+            }
+            else if ( !fold_case || !equalUnit(unit, units[bucket], true) ) {
+                perfect = false;
+            }
+        }
+
+        if ( perfect ) {
+            hash.seed = seed;
+        }
+    }
+}
+
+static const UnitsHashes& unitsHashes(void)
+{
+    static UnitsHashes hashes;
+    static const bool built = [](){
+        for(int i = 0; i < eUnitClassCount; i++)
+        {
+            buildUnitsHash(hashes.exact[i], unit_classes[i].units, unit_classes[i].units_len, false);
+            buildUnitsHash(hashes.folded[i], unit_classes[i].units, unit_classes[i].units_len, true);
+        }
+        return true;
+    }();
+
+    (void)built;
+    return hashes;
+}
+
+static int lookupUnit(const UnitsHash& hash, int unit_class, std::string_view unit, bool fold_case)
+{
+    const UnitClassInfo& info = unit_classes[unit_class];
+
+    if ( hash.seed == 0 ) {
+        for(int i = 0; i < info.units_len; i++)
+        {
+            if ( equalUnit(unit, info.units[i], fold_case) ) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int index = hash.buckets[hashUnit(unit, hash.seed, fold_case) & hash.mask];
+
+    if ( index >= 0 && equalUnit(unit, info.units[index], fold_case) ) {
+        return index;
+    }
+
+    return -1;
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	unitIndexInClass - Perfect hash lookup of a unit in a unit class </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         unit_class - UnitClassId of the units table to search
+///         unit - unit abbrev. to look up
+/// </parameters>
+/// <returns>   index of unit in the class's units or -1 if not found </returns>
+///-------------------------------------------------------------------------------------------------
+
+int unitIndexInClass(int unit_class, std::string_view unit)
+{
+#ifdef UNITS_CASE_INSENSITIVE
+    return unitIndexInClassNoCase(unit_class, unit);
+#else
+    return unitIndexInClassExact(unit_class, unit);
+#endif
+}
+
+int unitIndexInClassExact(int unit_class, std::string_view unit)
+{
+    if ( unit_class < 0 || unit_class >= eUnitClassCount ) {
+        return -1;
+    }
+
+    return lookupUnit(unitsHashes().exact[unit_class], unit_class, unit, false);
+}
+
+int unitIndexInClassNoCase(int unit_class, std::string_view unit)
+{
+    if ( unit_class < 0 || unit_class >= eUnitClassCount ) {
+        return -1;
+    }
+
+    return lookupUnit(unitsHashes().folded[unit_class], unit_class, unit, true);
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	IdentityConversionPlan - Plans a conversion that only tests for NaN </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+bool IdentityConversionPlan(ConversionPlan& plan, [[maybe_unused]] UnitConversion conversion, [[maybe_unused]] int in, [[maybe_unused]] int out,
+                            [[maybe_unused]] const engine_uv * params_list, [[maybe_unused]] size_t params_list_len)
+{
+    plan.kind = ePlanIdentity;
+    plan.scale = 1;
+    plan.offset = 0;
+    plan.power = 1;
+
+    return true;
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	ScaleConversionPlan - Plans a linear conversion engine </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         plan - resolved plan
+///         conversion - linear conversion engine, its factor is the conversion of 1
+///         in - unit index in
+///         out - unit index out
+///         params_list - parameters passed to the engine
+///         params_list_len - number of parameters in params_list
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+bool ScaleConversionPlan(ConversionPlan& plan, UnitConversion conversion, int in, int out,
+                         const engine_uv * params_list, size_t params_list_len)
+{
+    engine_uv factor = 1.0;
+
+    plan.kind = ePlanInvalid;
+    plan.scale = 1;
+    plan.offset = 0;
+    plan.power = 1;
+
+    if ( in == out ) {
+        plan.kind = ePlanIdentity;
+    }
+    else if ( conversion(factor, in, out, params_list, params_list_len) ) {
+        plan.kind = ePlanScale;
+        plan.scale = factor;
+    }
+
+    return ( plan.kind != ePlanInvalid );
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	makeConversionPlan - Resolves a conversion of a unit class into a plan </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         plan - resolved plan
+///         unit_class - UnitClassId of the units
+///         in - unit index in
+///         out - unit index out
+///         params_list - parameters of the conversion (i.e. impedance for power conversions)
+///         params_list_len - number of parameters in params_list
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+bool makeConversionPlan(ConversionPlan& plan, int unit_class, int in, int out,
+                        const engine_uv * params_list, size_t params_list_len)
+{
+    plan.kind = ePlanInvalid;
+    plan.scale = 1;
+    plan.offset = 0;
+    plan.power = 1;
+
+    if ( unit_class < 0 || unit_class >= eUnitClassCount ) {
+        return false;
+    }
+
+    const UnitClassInfo& info = unit_classes[unit_class];
+    if ( in < 0 || out < 0 || in >= info.units_len || out >= info.units_len ) {
+        return false;
+    }
+
+    return info.planner(plan, info.conversion, in, out, params_list, params_list_len);
+}
+
+/*
+ Plans of every (in, out) pair of a class with default parameters, indexed in*units_len + out
+ */
+static std::once_flag plans_built[eUnitClassCount];
+static std::vector<ConversionPlan> plans[eUnitClassCount];
+
+const ConversionPlan& conversionPlan(int unit_class, int in, int out)
+{
+    static const ConversionPlan invalid_plan = { ePlanInvalid, 1, 0, 1 };
+
+    if ( unit_class < 0 || unit_class >= eUnitClassCount ) {
+        return invalid_plan;
+    }
+
+    const int units_len = unit_classes[unit_class].units_len;
+    if ( in < 0 || out < 0 || in >= units_len || out >= units_len ) {
+        return invalid_plan;
+    }
+
+    std::call_once(plans_built[unit_class], [unit_class, units_len]() {
+        std::vector<ConversionPlan>& class_plans = plans[unit_class];
+        class_plans.resize(units_len*units_len);
+        for(int i = 0; i < units_len; i++)
+        {
+            for(int j = 0; j < units_len; j++)
+            {
+                makeConversionPlan(class_plans[i*units_len + j], unit_class, i, j);
+            }
+        }
+    });
+
+    return plans[unit_class][in*units_len + out];
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	makeExponentPlan - Resolves the conversion of a unit raised to an exponent </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         plan - resolved plan, factor^exponent of the plan of the unit
+///         unit_class - UnitClassId of the units
+///         in - unit index in
+///         out - unit index out
+///         exponent - exponent of the unit
+///         params_list - parameters of the conversion (i.e. impedance for power conversions)
+///         params_list_len - number of parameters in params_list
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+bool makeExponentPlan(ConversionPlan& plan, int unit_class, int in, int out, double exponent,
+                      const engine_uv * params_list, size_t params_list_len)
+{
+    if ( params_list && params_list_len ) {
+        makeConversionPlan(plan, unit_class, in, out, params_list, params_list_len);
+    }
+    else {
+        plan = conversionPlan(unit_class, in, out);
+    }
+
+    if ( exponent == 1 || plan.kind == ePlanInvalid || plan.kind == ePlanIdentity ) {
+        return ( plan.kind != ePlanInvalid );
+    }
+
+    if ( unit_classes[unit_class].engine_kind != eEngineLinear || plan.kind != ePlanScale ) {
+        // an offset or a log does not distribute over the powers of a unit
+        plan.kind = ePlanInvalid;
+        return false;
+    }
+
+    engine_uv factor = plan.scale;
+    double magnitude = exponent < 0 ? -exponent : exponent;
+    if ( magnitude <= 64 && magnitude == (double)(unsigned int)magnitude ) {
+        // square and multiply keeps integer exponents exact to the rounding of the factor
+        engine_uv scale = 1;
+        for(unsigned int bits = (unsigned int)magnitude; bits; bits >>= 1) {
+            if ( bits & 1 ) {
+                scale *= factor;
+            }
+            factor *= factor;
+        }
+        plan.scale = exponent < 0 ? 1/scale : scale;
+    }
+    else {
+        plan.scale = POW(factor, (engine_uv)exponent);
+    }
+
+    return true;
+}
+
+/*
+ Bulk conversion kernels - the NaN results are counted rather than stopping at the first
+ */
+static inline size_t countMaskBits(int mask)
+{
+    size_t bits = 0;
+    for(; mask; mask >>= 1) {
+        bits += (mask & 1);
+    }
+    return bits;
+}
+
+/*
+ SIMD part of the linear kernels - returns the number of values converted
+ */
+template<bool affine>
+static size_t linearKernelSimd(double * values, size_t count, double scale, double offset, size_t& nans)
+{
+    size_t i = 0;
+
+#if defined(UV_BULK_AVX2)
+    const __m256d vscale = _mm256_set1_pd(scale);
+    const __m256d voffset = _mm256_set1_pd(offset);
+    for(; i + 4 <= count; i += 4)
+    {
+        __m256d v = _mm256_mul_pd(_mm256_loadu_pd(values+i), vscale);
+        if ( affine ) {
+            v = _mm256_add_pd(v, voffset);
+        }
+        _mm256_storeu_pd(values+i, v);
+        nans += countMaskBits(_mm256_movemask_pd(_mm256_cmp_pd(v, v, _CMP_UNORD_Q)));
+    }
+#elif defined(UV_BULK_SSE2)
+    const __m128d vscale = _mm_set1_pd(scale);
+    const __m128d voffset = _mm_set1_pd(offset);
+    for(; i + 2 <= count; i += 2)
+    {
+        __m128d v = _mm_mul_pd(_mm_loadu_pd(values+i), vscale);
+        if ( affine ) {
+            v = _mm_add_pd(v, voffset);
+        }
+        _mm_storeu_pd(values+i, v);
+        nans += countMaskBits(_mm_movemask_pd(_mm_cmpunord_pd(v, v)));
+    }
+#endif
+
+    return i;
+}
+
+template<bool affine>
+static size_t linearKernelSimd(float * values, size_t count, float scale, float offset, size_t& nans)
+{
+    size_t i = 0;
+
+#if defined(UV_BULK_AVX2)
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 voffset = _mm256_set1_ps(offset);
+    for(; i + 8 <= count; i += 8)
+    {
+        __m256 v = _mm256_mul_ps(_mm256_loadu_ps(values+i), vscale);
+        if ( affine ) {
+            v = _mm256_add_ps(v, voffset);
+        }
+        _mm256_storeu_ps(values+i, v);
+        nans += countMaskBits(_mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)));
+    }
+#elif defined(UV_BULK_SSE2)
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 voffset = _mm_set1_ps(offset);
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 v = _mm_mul_ps(_mm_loadu_ps(values+i), vscale);
+        if ( affine ) {
+            v = _mm_add_ps(v, voffset);
+        }
+        _mm_storeu_ps(values+i, v);
+        nans += countMaskBits(_mm_movemask_ps(_mm_cmpunord_ps(v, v)));
+    }
+#endif
+
+    return i;
+}
+
+// long double has no vector registers
+template<bool affine>
+static size_t linearKernelSimd(long double *, size_t, long double, long double, size_t&)
+{
+    return 0;
+}
+
+template<bool affine, typename T>
+static size_t linearKernel(T * values, size_t count, T scale, T offset)
+{
+    size_t nans = 0;
+    size_t i = linearKernelSimd<affine>(values, count, scale, offset, nans);
+    UV_COUNT_VECTOR(i);
+
+    for(; i < count; i++)
+    {
+        T v = values[i]*scale;
+        if ( affine ) {
+            v = v + offset;
+        }
+        values[i] = v;
+        nans += ISNAN(v) ? 1 : 0;
+    }
+
+    return nans;
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	applyConversionPlanBulk - Applies a conversion plan to a buffer of values </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         plan - conversion plan
+///         values - values converted in place
+///         count - number of values
+/// </parameters>
+/// <returns>   number of NaN results, or count if the plan is invalid </returns>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+size_t applyConversionPlanBulk(const ConversionPlan& plan, T * values, size_t count)
+{
+    size_t nans = 0;
+    const T scale = (T)plan.scale;
+    const T offset = (T)plan.offset;
+    const T power = (T)plan.power;
+
+    if ( !values ) {
+        return 0;
+    }
+
+    switch(plan.kind) {
+        case ePlanIdentity:
+            for(size_t i = 0; i < count; i++) {
+                nans += ISNAN(values[i]) ? 1 : 0;
+            }
+            break;
+        case ePlanScale:
+            nans = linearKernel<false>(values, count, scale, (T)0);
+            break;
+        case ePlanAffine:
+            nans = linearKernel<true>(values, count, scale, offset);
+            break;
+        case ePlanToLog:
+            for(size_t i = 0; i < count; i++) {
+                values[i] = scale*std::log10(values[i]) + offset;
+                nans += ISNAN(values[i]) ? 1 : 0;
+            }
+            break;
+        case ePlanFromLog:
+            for(size_t i = 0; i < count; i++) {
+                values[i] = std::pow((T)10, values[i]*scale + offset);
+                nans += ISNAN(values[i]) ? 1 : 0;
+            }
+            break;
+        case ePlanPower:
+            for(size_t i = 0; i < count; i++) {
+                values[i] = ( values[i] < 0 ) ? (T)NAN : scale*std::pow(values[i], power);
+                nans += ISNAN(values[i]) ? 1 : 0;
+            }
+            break;
+        default:
+            nans = count;
+            break;
+    }
+
+    return nans;
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	convertBulk - Converts a buffer of values of a unit class </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+size_t convertBulk(int unit_class, T * values, size_t count, int in, int out,
+                   const engine_uv * params_list, size_t params_list_len)
+{
+    size_t nans = 0;
+
+    if ( params_list && params_list_len > 0 ) {
+        ConversionPlan plan;
+        makeConversionPlan(plan, unit_class, in, out, params_list, params_list_len);
+        nans = applyConversionPlanBulk(plan, values, count);
+    }
+    else {
+        nans = applyConversionPlanBulk(conversionPlan(unit_class, in, out), values, count);
+    }
+    UV_COUNT_CONVERSION(unit_class, in, out, count, nans);
+
+    return nans;
+}
+
+template size_t applyConversionPlanBulk<float>(const ConversionPlan& plan, float * values, size_t count);
+template size_t applyConversionPlanBulk<double>(const ConversionPlan& plan, double * values, size_t count);
+template size_t applyConversionPlanBulk<long double>(const ConversionPlan& plan, long double * values,
+                                                     size_t count);
+template size_t convertBulk<float>(int unit_class, float * values, size_t count, int in, int out,
+                                   const engine_uv * params_list, size_t params_list_len);
+template size_t convertBulk<double>(int unit_class, double * values, size_t count, int in, int out,
+                                    const engine_uv * params_list, size_t params_list_len);
+template size_t convertBulk<long double>(int unit_class, long double * values, size_t count, int in, int out,
+                                         const engine_uv * params_list, size_t params_list_len);
+
+/*
+ Bulk versions of the conversion engines
+ */
+#define BULK_CONVERSION(engine, unit_class)                                                     \
+template<typename T>                                                                            \
+size_t engine##Bulk(T * values, size_t count, int in, int out,                                  \
+                    const engine_uv * params_list, size_t params_list_len)                      \
+{                                                                                               \
+    return convertBulk(unit_class, values, count, in, out, params_list, params_list_len);       \
+}                                                                                               \
+template size_t engine##Bulk<float>(float * values, size_t count, int in, int out,              \
+                                    const engine_uv * params_list, size_t params_list_len);     \
+template size_t engine##Bulk<double>(double * values, size_t count, int in, int out,            \
+                                     const engine_uv * params_list, size_t params_list_len);    \
+template size_t engine##Bulk<long double>(long double * values, size_t count, int in, int out,  \
+                                          const engine_uv * params_list, size_t params_list_len);
+
+BULK_CONVERSION(IdentityConversion, eUnitScalar)
+BULK_CONVERSION(FreqConversion, eUnitFrequency)
+BULK_CONVERSION(AmplConversion, eUnitAmpl)
+BULK_CONVERSION(TimeConversion, eUnitTime)
+BULK_CONVERSION(DistanceConversion, eUnitDist)
+BULK_CONVERSION(TempConversion, eUnitTemp)
+BULK_CONVERSION(CurrentConversion, eUnitCurrent)
+BULK_CONVERSION(VolumeConversion, eUnitVolume)
+BULK_CONVERSION(MassConversion, eUnitMass)
+BULK_CONVERSION(ForceConversion, eUnitForce)
+BULK_CONVERSION(PressureConversion, eUnitPressure)
+BULK_CONVERSION(EnergyConversion, eUnitEnergy)
+BULK_CONVERSION(PowerConversion, eUnitPower)
+BULK_CONVERSION(AngleConversion, eUnitAngle)
+BULK_CONVERSION(AreaConversion, eUnitArea)
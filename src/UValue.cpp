@@ -8,7 +8,12 @@
 //  Copyright (c) 2014 by Michael Ryan
 ///-------------------------------------------------------------------------------------------------
 
-#include <typeinfo>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <cmath>
 #include "UValue.hpp"
 
 
@@ -18,6 +23,48 @@
 #define UVALUE_OPER_NOT_POSSIBLE                    0x00002
 
 
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Convert value_in between two units of a unit raised to exponent. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         unit_class - UnitClassId of the units (the cached plans are used) or -1
+///         conversion - conversion engine for units outside of the registered classes
+/// </parameters>
+/// Registered classes convert by factor^exponent, see makeExponentPlan.  Unregistered
+/// engines do not tell whether they are linear so the value goes through the root.
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+static bool convertWithExponent(int unit_class, UnitConversion conversion, T& value_in, double exponent,
+                                int unit_index_in, int unit_index_out,
+                                const engine_uv * params_list, size_t params_list_len)
+{
+    bool ret = false;
+    T sign = 1.0;
+
+    if ( exponent != 0 && unit_class >= 0 ) {
+        ret = convertWithExponentPlan(unit_class, value_in, unit_index_in, unit_index_out, exponent,
+                                      params_list, params_list_len);
+    }
+    else if ( exponent != 0 ) {
+        if ( exponent != 1 ) {
+            sign = ( value_in < 0 ) ? -1.0 : sign;
+            // ignore sign for now - imaginary numbers may come in the future
+            value_in = std::pow(std::fabs(value_in), 1.0/exponent);
+        }
+        // the engines of unregistered units run in engine_uv
+        engine_uv value = value_in;
+        ret = conversion(value, unit_index_in, unit_index_out, params_list, params_list_len);
+        value_in = (T)value;
+        if ( exponent != 1 ) {
+            value_in = std::pow(value_in, exponent);
+            value_in = sign*value_in;
+        }
+    }
+
+    return ret;
+}
+
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Atomic Unit Class. </summary>
 ///
@@ -41,9 +88,9 @@
 /// </parameters>
 ///-------------------------------------------------------------------------------------------------
 AtomicUnit::AtomicUnit(const char *const* units_in, int len, UnitConversion unit_conv)
-            : exponent(1), units(units_in), len_units(len)
-            , params_list(nullptr), params_list_len(0)
-            , conversion(unit_conv), cur_unit(nullptr) {
+            : units(units_in), len_units(len)
+            , params_list(nullptr), params_list_len(0), resource(nullptr)
+            , conversion(unit_conv), unit_class(unitClassOfUnits(units_in)), exponent(1), cur_unit(nullptr) {
     if ( units_in ) {
         cur_index = 0;
         def_unit = units_in[cur_index];
@@ -66,21 +113,21 @@ AtomicUnit::AtomicUnit(const char *const* units_in,
                     int len, UnitConversion unit_conv,
                     const char * current_unit,
                     const char * default_unit,
-                    double_uv * params, int params_len)
-            : params_list(nullptr), cur_unit(nullptr)
-            , exponent(1), units(units_in), len_units(len), params_list_len(0)
-            , conversion(unit_conv) {
+                    engine_uv * params, int params_len)
+            : units(units_in), len_units(len), params_list(nullptr), params_list_len(0)
+            , resource(nullptr), conversion(unit_conv), unit_class(unitClassOfUnits(units_in))
+            , exponent(1), cur_unit(nullptr) {
     if ( len_units ) {
-        cur_index = (*this)[current_unit];
+        cur_index = indexOrDefault(current_unit, 0);
         cur_unit = units[cur_index];
         
-        def_unit = units[(*this)[default_unit]];
+        def_unit = units[indexOrDefault(default_unit, 0)];
         if ( !default_unit ) {
             def_unit = units[0];
         }
         
         if ( params != nullptr && params_len > 0 ) {
-            params_list = new double_uv[params_len];
+            params_list = allocParams(params_len);
             params_list_len = params_len;
             for(int i = 0; i < params_len; ++i) {
                 params_list[i] = params[i];
@@ -89,12 +136,71 @@ AtomicUnit::AtomicUnit(const char *const* units_in,
     }
 }
 ///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit Constructor for a registered unit class. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         unit_class_in - unit class (units, UnitConversion and the default unit are
+///                         taken from unit_classes)
+///         current_unit - starting unit (abbrev. from the class's units, nullptr for the default)
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+AtomicUnit::AtomicUnit(UnitClassId unit_class_in, const char * current_unit)
+            : units(unit_classes[unit_class_in].units), len_units(unit_classes[unit_class_in].units_len)
+            , params_list(nullptr), params_list_len(0), resource(nullptr)
+            , conversion(unit_classes[unit_class_in].conversion), unit_class(unit_class_in)
+            , exponent(1), cur_unit(nullptr) {
+    const int default_index = unit_classes[unit_class_in].default_unit;
+    
+    cur_index = current_unit ? indexOrDefault(current_unit, 0) : default_index;
+    cur_unit = units[cur_index];
+    def_unit = units[default_index];
+}
+// unit class of a record, or scalar if it names none
+static UnitClassId recordClass(const UnitRecord& record)
+{
+    if ( record.unit_class >= 0 && record.unit_class < eUnitClassCount ) {
+        return (UnitClassId)record.unit_class;
+    }
+    return eUnitScalar;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit Constructor from a Unit Record. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             A record of no unit class gives a scalar. </remarks>
+///-------------------------------------------------------------------------------------------------
+AtomicUnit::AtomicUnit(const UnitRecord& record)
+            : AtomicUnit(recordClass(record)) {
+    if ( unit_class != record.unit_class ) {
+        return;
+    }
+    if ( record.index >= 0 && record.index < (int)len_units ) {
+        cur_index = record.index;
+        cur_unit = units[cur_index];
+    }
+    exponent = record.exponent;
+}
+///-------------------------------------------------------------------------------------------------
 /// <summary>	Atomic Unit Copy Constructor. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
 AtomicUnit::AtomicUnit(const AtomicUnit& au)
-    : params_list(nullptr), params_list_len(0) {
+    : AtomicUnit(au, nullptr) {
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit Copy Constructor allocating from a memory resource. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         au - unit to copy
+///         resource_in - memory resource of the parameters list (nullptr for new[])
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+AtomicUnit::AtomicUnit(const AtomicUnit& au, std::pmr::memory_resource * resource_in)
+    : params_list(nullptr), params_list_len(0), resource(resource_in) {
+    this->unit_class = au.unit_class;
     this->exponent = au.exponent;
     this->units = au.units;
     this->len_units = au.len_units;
@@ -103,12 +209,32 @@ AtomicUnit::AtomicUnit(const AtomicUnit& au)
     this->cur_unit = au.cur_unit;
     this->cur_index = au.cur_index;
     
-
-    this->params_list = new double_uv[au.params_list_len];
-    for(size_t i = 0; i < au.params_list_len; ++i) {
-        *(this->params_list+i) = *(au.params_list+i);
+    if ( au.params_list_len ) {
+        this->params_list = allocParams(au.params_list_len);
+        for(size_t i = 0; i < au.params_list_len; ++i) {
+            *(this->params_list+i) = *(au.params_list+i);
+        }
+        this->params_list_len = au.params_list_len;
     }
-    this->params_list_len = au.params_list_len;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit Move Constructor. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+AtomicUnit::AtomicUnit(AtomicUnit&& au) noexcept
+    : params_list(au.params_list), params_list_len(au.params_list_len), resource(au.resource) {
+    this->unit_class = au.unit_class;
+    this->exponent = au.exponent;
+    this->units = au.units;
+    this->len_units = au.len_units;
+    this->def_unit = au.def_unit;
+    this->conversion = au.conversion;
+    this->cur_unit = au.cur_unit;
+    this->cur_index = au.cur_index;
+    
+    au.params_list = nullptr;
+    au.params_list_len = 0;
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Atomic Unit Destructor. </summary>
@@ -116,8 +242,38 @@ AtomicUnit::AtomicUnit(const AtomicUnit& au)
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
 AtomicUnit::~AtomicUnit(void) {    
+    freeParams();
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit parameters list storage from the unit's memory resource. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+engine_uv * AtomicUnit::allocParams(size_t params_len)
+{
+    UV_COUNT_ALLOCATION(eAllocUnitParams, unit_class);
+    if ( resource ) {
+        return static_cast<engine_uv *>(resource->allocate(params_len*sizeof(engine_uv), alignof(engine_uv)));
+    }
+
+    return new engine_uv[params_len];
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit parameters list returned to the unit's memory resource. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+void AtomicUnit::freeParams(void)
+{
     if ( params_list ) {
-        delete [] params_list;
+        if ( resource ) {
+            resource->deallocate(params_list, params_list_len*sizeof(engine_uv), alignof(engine_uv));
+        }
+        else {
+            delete [] params_list;
+        }
+        params_list = nullptr;
+        params_list_len = 0;
     }
 }
 
@@ -126,27 +282,16 @@ AtomicUnit::~AtomicUnit(void) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-bool AtomicUnit::convert (double_uv& value_in, int unit_index_out)
+bool AtomicUnit::convert (engine_uv& value_in, int unit_index_out)
 {
     bool ret = false;
-    double_uv sign = 1.0;
     
     if ( (size_t)unit_index_out < len_units ) {
-        if ( this->exponent != 0 ) {
-            if ( this->exponent != 1 ) {
-                sign = ( value_in < 0 ) ? -1.0 : sign;
-                // ignore sign for now - imaginary numbers may come in the future
-                value_in = pow(fabs(value_in), 1.0/exponent);
-            }
-            ret = conversion(value_in, cur_index, unit_index_out, params_list, params_list_len);
-            if ( this->exponent != 1 ) {
-                value_in = pow(value_in, exponent);
-                value_in = sign*value_in;
-            }
-            if ( ret ) {
-                cur_index = unit_index_out;
-                cur_unit = units[cur_index];
-            }
+        ret = convertWithExponent(unit_class, conversion, value_in, exponent, cur_index, unit_index_out,
+                                  params_list, params_list_len);
+        if ( ret ) {
+            cur_index = unit_index_out;
+            cur_unit = units[cur_index];
         }
     }
     
@@ -158,37 +303,29 @@ bool AtomicUnit::convert (double_uv& value_in, int unit_index_out)
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
 bool AtomicUnit::sameUnits(const AtomicUnit * au) const {
-    bool ret = false;
-    if ( au->len_units == len_units ) {
-        ret = true;
-        for(size_t i = 0; i < len_units; ++i ) {
-            ret &= (strlen(units[i]) == strlen(au->units[i]) && (STRCMP(au->units[i], units[i]) == 0));
-        }
-    }
-    
-    return ret;
+    // every unit class has its own static units table
+    return ( au->units == units );
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Atomic Unit Set Parameters List. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void AtomicUnit::setParams(double_uv * params, size_t params_len)
+void AtomicUnit::setParams(engine_uv * params, size_t params_len)
 {
-    if ( *params_list ) {
-        delete [] params_list;
-    }
+    freeParams();
     
-    params_list = new double_uv[params_len];
+    params_list = allocParams(params_len);
+    params_list_len = params_len;
     
-    memcpy(params_list, params, params_len);
+    memcpy(params_list, params, params_len*sizeof(engine_uv));
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Atomic Unit Get Parameters List. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-const double_uv * AtomicUnit::getParams(void)
+const engine_uv * AtomicUnit::getParams(void)
 {
     return params_list;
 }
@@ -197,17 +334,23 @@ const double_uv * AtomicUnit::getParams(void)
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void AtomicUnit::setParam(double_uv param, size_t index)
+void AtomicUnit::setParam(engine_uv param, size_t index)
 {
-    double_uv * params = params_list;
+    engine_uv * params = params_list;
     size_t new_len = index+1;
     if ( new_len > params_list_len ) {
-        params = new double_uv[new_len];
+        params = allocParams(new_len);
         
-        memcpy(params, params_list, new_len);
+        if ( params_list_len ) {
+            memcpy(params, params_list, params_list_len*sizeof(engine_uv));
+        }
+        for(size_t i = params_list_len; i < new_len; ++i) {
+            params[i] = 0;
+        }
         
-        delete [] params_list;
+        freeParams();
         params_list = params;
+        params_list_len = new_len;
     }
     
     *(params + index) = param;
@@ -217,11 +360,14 @@ void AtomicUnit::setParam(double_uv param, size_t index)
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-double_uv AtomicUnit::getParam(size_t index)
+engine_uv AtomicUnit::getParam(size_t index)
 {
     if ( index < params_list_len ) {
         return params_list[index];
     }
+    if ( unit_class >= 0 && index < (size_t)unit_classes[unit_class].params_len ) {
+        return unit_classes[unit_class].params[index];
+    }
     return NAN;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -243,19 +389,28 @@ const char * AtomicUnit::operator[] (const int index) const {
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
 int AtomicUnit::operator[] (const char * pszUnits) const {
-    int ret = 0;
-    if ( pszUnits && strlen(pszUnits) ) {
-        for(size_t i = 0; i < len_units; ++i) {
-            const char * unit = *(units+i);
-            size_t len = strlen(pszUnits) ;
-            if ( strlen(unit) == len
-                && STRCMP(unit , pszUnits) == 0 ) {
-                ret = (int)i;
-                break;
-            }
-        }
+    if ( !pszUnits ) {
+        return -1;
     }
-    return ret;
+    return (*this)[std::string_view(pszUnits)];
+}
+
+int AtomicUnit::operator[] (std::string_view unit) const {
+    int ret = -1;
+    if ( unit.size() ) {
+        ret = ( unit_class >= 0 ) ? unitIndexInClass(unit_class, unit)
+                                  : unitIndexInUnits(unit, units, (int)len_units);
+    }
+    return ( ret >= 0 ) ? ret : -1;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Index of abbrev., or index_missing if it is not one of the units. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+int AtomicUnit::indexOrDefault(const char * pszUnits, int index_missing) const {
+    int index = (*this)[pszUnits];
+    return ( index >= 0 ) ? index : index_missing;
 }
     
 ///-------------------------------------------------------------------------------------------------
@@ -307,7 +462,11 @@ std::string AtomicUnit::printUnits(void) {
 /// <remarks>	Michael Ryan, 6/11/20123 </remarks>
 ///-------------------------------------------------------------------------------------------------
 bool AtomicUnit::sameUnitType(const AtomicUnit * unitToCompare) const {
-    return (STRCMP(this->getName(), unitToCompare->getName()) == 0);
+    if ( this->unit_class >= 0 ) {
+        return ( this->unit_class == unitToCompare->unit_class );
+    }
+    
+    return sameUnits(unitToCompare);
 }
 
 ///-------------------------------------------------------------------------------------------------
@@ -316,11 +475,122 @@ bool AtomicUnit::sameUnitType(const AtomicUnit * unitToCompare) const {
 /// <remarks>	Michael Ryan, 6/11/20123 </remarks>
 ///-------------------------------------------------------------------------------------------------
 const char * AtomicUnit::getName(void) const {
-    return typeid(*this).name();
+    if ( unit_class >= 0 ) {
+        return unit_classes[unit_class].name;
+    }
+    return "Custom";
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit as a Unit Record. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+UnitRecord AtomicUnit::record(void) const {
+    UnitRecord rec = { (short)unit_class, (short)cur_index, exponent };
+    return rec;
 }
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Table of the units of a parsed unit target. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+UnitTargetError UnitTable::fromTarget(const UnitTarget& target, unsigned int held) {
+    const unsigned int dimensional = dimensionalClassMask();
     
+    _present = 0;
+    for(int i = 0; i < target.factors_len; ++i)
+    {
+        const UnitTargetFactor& factor = target.factors[i];
+        unsigned int classes = factor.classes & held;
+        if ( !classes ) {
+            classes = ( factor.classes & dimensional ) ? factor.classes & dimensional : factor.classes;
+            classes &= ~classes + 1;
+        }
+        for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+        {
+            if ( !(classes & (1u << unit_class)) ) {
+                continue;
+            }
+            if ( !contains(unit_class) ) {
+                insert(unit_class, factor.index[unit_class], factor.exponent);
+            }
+            else if ( _slots[unit_class].cur_index == factor.index[unit_class] ) {
+                _slots[unit_class].exponent += factor.exponent;
+            }
+            else {
+                return eTargetRepeatedClass;
+            }
+        }
+    }
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( contains(unit_class) && _slots[unit_class].exponent == 0 ) {
+            erase(unit_class);
+        }
+    }
+    
+    return eTargetOk;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Table of a unit expression. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+UnitTargetError UnitTable::parse(std::string_view units) {
+    const UnitTarget * target = nullptr;
+    UnitTarget scratch;
+    UnitTargetError ret = cachedUnitTarget(units, target, scratch);
+    
+    return ( ret == eTargetOk ) ? fromTarget(*target) : ret;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit Create - new unit of the same class in its default unit. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+AtomicUnit * AtomicUnit::create(void) const {
+    if ( unit_class >= 0 ) {
+        return new AtomicUnit((UnitClassId)unit_class);
+    }
+    return new AtomicUnit(units, (int)len_units, conversion);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit Clone. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+AtomicUnit * AtomicUnit::clone(void) const {
+    UV_COUNT_CLONE(unit_class);
+    return new AtomicUnit(*this);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit Clone into a memory resource. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+AtomicUnit * AtomicUnit::clone(std::pmr::memory_resource * resource_in) const {
+    UV_COUNT_CLONE(unit_class);
+    void * storage = resource_in->allocate(sizeof(AtomicUnit), alignof(AtomicUnit));
+    return new (storage) AtomicUnit(*this, resource_in);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Atomic Unit Destroy - deletes the unit or returns it to its memory resource. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+void AtomicUnit::destroy(void) {
+    std::pmr::memory_resource * resource_in = resource;
+    if ( !resource_in ) {
+        delete this;
+        return;
+    }
+    // only clone(resource) places units in a resource, and it makes plain AtomicUnits
+    this->~AtomicUnit();
+    resource_in->deallocate(this, sizeof(AtomicUnit), alignof(AtomicUnit));
+}
+
 
-AtomicUnit& AtomicUnit::operator=(const AtomicUnit &unit_in) {
+AtomicUnit& AtomicUnit::operator=([[maybe_unused]] const AtomicUnit &unit_in) {
     return *this;
 }
 
@@ -345,38 +615,68 @@ std::ostream& operator<<(std::ostream& out, AtomicUnit * unit)
 }
 
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Scalar Unit - unitless class. </summary>
+/// <summary>	Unit Group - group of folded units. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
 
-ScalarUnit::ScalarUnit(void)
-    : AtomicUnit(scalar, 1, IdentityConversion, "", "")
-{
-}
-
-ScalarUnit * ScalarUnit::create(void)
+/*
+ Units of unit_class are held in the default unit of the class, so values of that class
+ multiply and add without a conversion (UV_CANONICAL_STORAGE and linear classes only)
+ */
+static inline bool storedInDefaultUnit(int unit_class)
 {
-    return new ScalarUnit();
+#ifdef UV_CANONICAL_STORAGE
+    return ( unit_classes[unit_class].engine_kind == eEngineLinear );
+#else
+    (void)unit_class;
+    return false;
+#endif
 }
 
-ScalarUnit * ScalarUnit::clone(void) const
-{
-    return new ScalarUnit(*this);
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Group value in the units of the group from the stored value. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+T BasicUnitGroup<T>::fromStored(T value) const {
+#ifdef UV_CANONICAL_STORAGE
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( _units.contains(unit_class) && storedInDefaultUnit(unit_class) ) {
+            const UnitSlot& au = _units[unit_class];
+            convertWithExponentPlan(unit_class, value, unit_classes[unit_class].default_unit,
+                                    au.cur_index, au.exponent);
+        }
+    }
+#endif
+    return value;
 }
-
-// end class ScalarUnit
-
-
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Unit Group - group of folded units. </summary>
+/// <summary>	Unit Group stored value from a value in the units of the group. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
+template<typename T>
+T BasicUnitGroup<T>::toStored(T value) const {
+#ifdef UV_CANONICAL_STORAGE
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( _units.contains(unit_class) && storedInDefaultUnit(unit_class) ) {
+            const UnitSlot& au = _units[unit_class];
+            convertWithExponentPlan(unit_class, value, au.cur_index,
+                                    unit_classes[unit_class].default_unit, au.exponent);
+        }
+    }
+#endif
+    return value;
+}
 
 
-UnitGroup::UnitGroup(void)
-    : _oper(0), _val(0)
+template<typename T>
+BasicUnitGroup<T>::BasicUnitGroup(void)
+    : _val(0), _oper(0)
 {}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Group Constructor. </summary>
@@ -388,60 +688,77 @@ UnitGroup::UnitGroup(void)
 ///         op - operator relation to other unit groups
 /// </parameters>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup::UnitGroup(double_uv val, AtomicUnit * unit, char op)
-    : _oper(op), _val(val) {
+template<typename T>
+BasicUnitGroup<T>::BasicUnitGroup(T val, AtomicUnit * unit, char op)
+    : _val(val), _oper(op) {
     if ( unit != nullptr ) {
-        std::string name = unit->getName();
-        this->_units[name.c_str()] = unit->clone();
+        if ( !setUnit(*unit) ) {
+            val = NAN;
+        }
+        _val = toStored(val);
     }
 }
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Unit Group Copy Constructor. </summary>
+/// <summary>	Unit Group Constructor from a unit value (copied into the group). </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup::UnitGroup(double_uv val, char oper, const MAP_ATOMIC_UNITS &units_in)
-    : _val(val), _oper(oper) {
-    // remember that one can not simply copy MAP_ATOMIC_UNITS yet
-    // one must clone each unit key-value pair
-    for (MAP_ATOMIC_UNITS::const_iterator iter = units_in.begin() ; iter != units_in.end(); ++iter) {
-        this->_units[iter->second->getName()] = iter->second->clone();
+template<typename T>
+BasicUnitGroup<T>::BasicUnitGroup(T val, const AtomicUnit& unit, char op)
+    : _val(val), _oper(op) {
+    if ( !setUnit(unit) ) {
+        val = NAN;
+    }
+    _val = toStored(val);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Group add unit to the Unit Table. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             A unit of a units table that is not registered in unit_classes has no slot,
+///             so it is not added and the caller marks the value NaN. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+bool BasicUnitGroup<T>::setUnit(const AtomicUnit& unit) {
+    int unit_class = unit.unit_class;
+    if ( unit_class < 0 || unit.cur_index < 0 || unit.params_list_len > UNIT_SLOT_PARAMS ) {
+        return false;
     }
+    this->_units.insert(unit_class, unit.cur_index, unit.exponent,
+                        unit.params_list, unit.params_list_len);
+    return true;
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Group Copy Constructor. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup::UnitGroup(const UnitGroup& unit_in)
-    : _val(unit_in.getValue()), _oper(unit_in.getOper()) {
-    
-    for(MAP_ATOMIC_UNITS::const_iterator iter = unit_in.getUnits().begin();
-        iter != unit_in.getUnits().end();
-        ++iter
-        )
-    {
-        if ( (*iter).second != nullptr ) {
-            std::string name = (*iter).first;
-            this->_units[name] = ((*iter).second)->clone();
-        }
-    }
+template<typename T>
+BasicUnitGroup<T>::BasicUnitGroup(T val, char oper, const UnitTable &units_in)
+    : _val(val), _oper(oper), _units(units_in) {
+    _val = toStored(val);
 }
-    
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Unit Group Destructor. </summary>
+/// <summary>	Unit Group Constructor from a unit expression. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup::~UnitGroup(void) {
-    deleteAllUnits();
+template<typename T>
+BasicUnitGroup<T>::BasicUnitGroup(T val, std::string_view units)
+    : _val(val), _oper(0) {
+    if ( _units.parse(units) != eTargetOk ) {
+        _units = UnitTable();
+        val = NAN;
+    }
+    _val = toStored(val);
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Compare Unit Groups. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-int UnitGroup::compareUnits(const MAP_ATOMIC_UNITS& units_in) const {
+template<typename T>
+int BasicUnitGroup<T>::compareUnits(const UnitTable& units_in) const {
     int ret = 0;
     
     if ( this->areUnitsEqual(units_in) ) {
@@ -455,181 +772,358 @@ int UnitGroup::compareUnits(const MAP_ATOMIC_UNITS& units_in) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-bool UnitGroup::areUnitsEqual(const MAP_ATOMIC_UNITS& units_in) const {
-    bool ret = false;
+template<typename T>
+bool BasicUnitGroup<T>::areUnitsEqual(const UnitTable& units_in) const {
+    const unsigned int dimensional = dimensionalClassMask();
+    const unsigned int present = _units.mask();
+    const unsigned int present_in = units_in.mask();
     
-    if ( units_in.size() == this->_units.size() ) {
-        ret = true;
-        for(MAP_ATOMIC_UNITS::const_iterator iter = _units.begin();
-            iter != _units.end();
-            ++iter)
-        {
-            if ( units_in.find((*iter).first) != units_in.end() ) {
-                ret &= (*(*iter).second == units_in.at((*iter).first));
-            }
-            else {
-                ret = false;
-            }
+    // the classes with no dimension must be the same
+    if ( (present ^ present_in) & ~dimensional ) {
+        return false;
+    }
+    
+    // one pass over the exponents that differ - whole ones as the difference of packed keys
+    bool whole = true;
+    long long key_diff = 0;
+    int unit_class = 0;
+    for(unsigned int classes = present | present_in; classes; classes >>= 1, ++unit_class)
+    {
+        if ( !(classes & 1) ) {
+            continue;
+        }
+        
+        const double exponent = _units.contains(unit_class) ? _units[unit_class].exponent : 0;
+        const double exponent_in = units_in.contains(unit_class) ? units_in[unit_class].exponent : 0;
+        if ( exponent == exponent_in ) {
+            continue;
+        }
+        if ( !(dimensional & (1u << unit_class)) ) {
+            return false;
+        }
+        
+        whole &= ( exponent >= -DIMENSION_KEY_MAX_EXPONENT && exponent <= DIMENSION_KEY_MAX_EXPONENT
+                   && exponent == (double)(int)exponent
+                   && exponent_in >= -DIMENSION_KEY_MAX_EXPONENT && exponent_in <= DIMENSION_KEY_MAX_EXPONENT
+                   && exponent_in == (double)(int)exponent_in );
+        if ( whole ) {
+            key_diff += ((int)exponent - (int)exponent_in)*unit_classes[unit_class].dimension_key;
         }
     }
     
-    return ret;
+    if ( whole ) {
+        return ( key_diff == 0 );
+    }
+    
+    double dims[eDimCount];
+    double dims_in[eDimCount];
+    _units.dimensions(dims, dimensional);
+    units_in.dimensions(dims_in, dimensional);
+    for(int d = 0; d < eDimCount; ++d)
+    {
+        if ( dims[d] != dims_in[d] ) {
+            return false;
+        }
+    }
+    
+    return true;
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Fold in units from operating Unit Group according to supplied operator. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-bool UnitGroup::foldInUnit(char oper, const UnitGroup &unit) {
+template<typename T>
+bool BasicUnitGroup<T>::foldInUnit(char oper, const BasicUnitGroup<T> &unit) {
     bool ret = true;
-    double_uv conv_value = unit.getValue();
-    if ( unit.getUnits().size() && _units.size() ) {
-        for(MAP_ATOMIC_UNITS::const_iterator iter = unit.getUnits().begin();
-            iter != unit.getUnits().end();
-            ++iter) {
-            AtomicUnit * au_in = iter->second;
-            const std::string name = au_in->getName();
-            if ( _units.count(name) == 1 ) {
-                AtomicUnit * au = _units[name];
-                if ( au->conversion(conv_value, (*au)[au_in->cur_unit], (*au)[au->cur_unit], au->params_list, au->params_list_len ) )
-                {
-                    switch(oper) {
-                        case '*':
-							au->exponent += au_in->exponent;
-							break;
-                        case '/':
-							au->exponent -= au_in->exponent;
-							break;
+    T conv_value = unit._val;
+    const UnitTable& units_in = unit.getUnits();
 
-                    }
-                    
-                    if ( au->exponent == 0 ) {
-                        deleteUnit(name);
-                    }
-                }
-            } // if ( _units.count(name) == 1 )
-            else {
-                // copy
-                AtomicUnit * clone = au_in->clone();
-                
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class) {
+        if ( !units_in.contains(unit_class) ) {
+            continue;
+        }
+
+        const UnitSlot& au_in = units_in[unit_class];
+        if ( _units.contains(unit_class) ) {
+            UnitSlot& au = _units[unit_class];
+            if ( storedInDefaultUnit(unit_class)
+                 || (au_in.cur_index == au.cur_index && !ISNAN(conv_value))
+                 || convertWithExponentPlan(unit_class, conv_value, au_in.cur_index, au.cur_index,
+                                            au_in.exponent, au_in.params, au_in.params_len) )
+            {
                 switch(oper) {
                     case '*':
-						clone->exponent = au_in->exponent;
-						break;
+                        au.exponent += au_in.exponent;
+                        break;
                     case '/':
-						clone->exponent = -au_in->exponent;
-						break;
+                        au.exponent -= au_in.exponent;
+                        break;
                 }
                 
-                _units[au_in->getName()] = clone;
+                if ( au.exponent == 0 ) {
+                    deleteUnit(unit_class);
+                }
+            }
+        } // if ( _units.contains(unit_class) )
+        else {
+            // copy
+            UnitSlot& au = _units.insert(unit_class, au_in.cur_index, au_in.exponent,
+                                         au_in.params, au_in.params_len);
+            
+            if ( oper == '/' ) {
+                au.exponent = -au_in.exponent;
             }
-        } // for iter != unit.getUnits().end()
-        switch (oper) {
-            case '*':
-				_val *= conv_value;
-				break;
-
-            case '/':
-				_val /= conv_value;
-				break;
-        }
-    } // if ( unit.getUnits().size() && _units.size() )
-    else {
-        switch(oper) {
-            case '*':
-				_val *= unit.getValue();
-				break;
-            case '/':
-				_val /= unit.getValue();
-				break;
         }
+    } // for unit_class < eUnitClassCount
+
+    switch (oper) {
+        case '*':
+            _val *= conv_value;
+            break;
+
+        case '/':
+            _val /= conv_value;
+            break;
     }
     
     return ret;
 }
 ///-------------------------------------------------------------------------------------------------
+/// <summary>	Reduce the result of a product or quotient of units. </summary>
+///
+/// <remarks>	Michael Ryan, 4/25/2016. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+void BasicUnitGroup<T>::reduceProduct(void) {
+#ifdef UV_AUTO_REDUCE
+    reduceWith(nullptr, nullptr);
+#endif
+}
+///-------------------------------------------------------------------------------------------------
 /// <summary>	Sum Units. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-bool UnitGroup::sumUnits(char oper, const UnitGroup& unit) {
+template<typename T>
+bool BasicUnitGroup<T>::sumUnits(char oper, const BasicUnitGroup<T>& unit) {
+    T conv_value;
+    
+    if ( !(*this == unit) ) {
+        _val = T();
+        return false;
+    }
+    
+    bool ret = likeValue(unit, conv_value);
+    if ( ret ) {
+        switch(oper) {
+            case '+':
+                _val += conv_value;
+                break;
+            case '-':
+                _val -= conv_value;
+                break;
+        }
+    }
+    
+    return ret;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Value of a like Unit Group in the units of this one. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             Units matched by dimension are scaled through the SI units in one factor, the
+///             others are converted class by class.  unit must be like this group
+///             (see operator==). </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+bool BasicUnitGroup<T>::likeValue(const BasicUnitGroup<T>& unit, T& conv_value) const {
     bool ret = true;
-    double_uv conv_value = unit.getValue();
+    const UnitTable& units_in = unit.getUnits();
+    const bool same_classes = _units.sameClasses(units_in);
+    const unsigned int dimensional = same_classes ? 0 : dimensionalClassMask();
+    
+    conv_value = unit._val;
+    if ( !same_classes ) {
+        // like by dimension - one factor through the SI units
+        conv_value *= unit.dimensionScale()/dimensionScale();
+    }
+    for(int unit_class = 0; ret && unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( units_in.contains(unit_class) && !storedInDefaultUnit(unit_class)
+             && !(dimensional & (1u << unit_class))
+             && (units_in[unit_class].cur_index != _units[unit_class].cur_index || ISNAN(conv_value)) ) {
+            const UnitSlot& au = units_in[unit_class];
+            ret = convertWithExponentPlan(unit_class, conv_value, au.cur_index,
+                                          _units[unit_class].cur_index, au.exponent,
+                                          au.params, au.params_len);
+        }
+    }
     
-    if ( *this == unit ) {
-        for(MAP_ATOMIC_UNITS::const_iterator iter = unit.getUnits().begin();
-            iter != unit.getUnits().end();
-            ++iter)
-        {
-            const AtomicUnit * au = unit.getUnits().at((*iter).first);
-            if ( ((*iter).second)->conversion(conv_value,  (*au)[au->cur_unit]
-                                              , (*au)[_units[(*iter).first]->cur_unit]
-                                              , au->params_list, au->params_list_len ) ) {
-                switch(oper) {
-                    case '+':
-						_val += conv_value;
-						break;
-                    case '-':
-						_val -= conv_value;
-						break;
-                }
-            }
+    return ret;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Factor from the SI units of the dimensions of the group to its units. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+T BasicUnitGroup<T>::dimensionScale(void) const {
+    const unsigned int dimensional = dimensionalClassMask();
+    T scale = 1;
+    
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( _units.contains(unit_class) && (dimensional & (1u << unit_class)) ) {
+            // held in the default unit of the class under UV_CANONICAL_STORAGE
+            int index = storedInDefaultUnit(unit_class) ? unit_classes[unit_class].default_unit
+                                                        : _units[unit_class].cur_index;
+            scale *= (T)dimensionFactor(unit_class, index, _units[unit_class].exponent);
+        }
+    }
+    
+    return scale;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Reduce to more legible units series. </summary>
+///
+/// <remarks>	Michael Ryan, 4/25/2016. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUnitGroup<T>& BasicUnitGroup<T>::reduce(const char * units, const Reducer& rule) {
+    return reduceWith(units, &rule);
+}
+template<typename T>
+BasicUnitGroup<T>& BasicUnitGroup<T>::reduce(const char * units) {
+    return reduceWith(units, nullptr);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Reduce with the unit named units, or else the unit given by rule. </summary>
+///
+/// <remarks>	Michael Ryan, 4/25/2016. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUnitGroup<T>& BasicUnitGroup<T>::reduceWith(const char * units, const Reducer * rule) {
+    const unsigned int dimensional = dimensionalClassMask();
+    const unsigned int held = _units.mask() & dimensional;
+    long long key;
+    
+    // nothing to reduce - no units with a dimension, a fractional exponent or, with no units
+    // or rule given, a single unit
+    if ( !held || !_units.dimensionKey(key, dimensional) ) {
+        return *this;
+    }
+    int held_class = -1;
+    if ( !(held & (held - 1)) ) {
+        for(held_class = 0; !(held & (1u << held_class)); ++held_class) {}
+        if ( !units && !rule && _units[held_class].exponent == 1 ) {
+            return *this;
+        }
+    }
+    
+    int unit_class = -1;
+    int unit_index = -1;
+    if ( units ) {
+        unit_class = unitClassOfDimension(key);
+        unit_index = ( unit_class >= 0 ) ? unitIndexInClass(unit_class, units) : -1;
+    }
+    else if ( rule ) {
+        if ( !rule->derivedUnit(key, unit_class, unit_index) ) {
+            return *this;
         }
-    } // if ( *this == unit )
+    }
     else {
-        _val = double_uv();
-        ret = false;
+        unit_class = unitClassOfDimension(key);
+        unit_index = ( unit_class >= 0 ) ? unit_classes[unit_class].si_unit : -1;
     }
     
-    return ret;
+    if ( unit_class < 0 || unit_index < 0 || unit_index >= unit_classes[unit_class].units_len
+         || !(dimensional & (1u << unit_class))
+         || (held_class == unit_class && _units[held_class].exponent == 1
+             && _units[held_class].cur_index == unit_index) ) {
+        return *this;
+    }
+    
+    const CrossClassRoute route = { unit_class, 1, -1, 0 };
+    replaceDimensionalUnits(route, unit_index);
+    
+    return *this;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Replace the units matched by dimension along route. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+void BasicUnitGroup<T>::replaceDimensionalUnits(const UnitTable& units) {
+    const unsigned int held = _units.mask() & dimensionalClassMask();
+    
+    // one factor through the SI units of the dimensions
+    T value = _val*dimensionScale();
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( held & (1u << unit_class) ) {
+            deleteUnit(unit_class);
+        }
+        if ( units.contains(unit_class) ) {
+            _units.insert(unit_class, units[unit_class].cur_index, units[unit_class].exponent);
+        }
+    }
+    // dimensionScale holds the default unit of a class under UV_CANONICAL_STORAGE
+    _val = value/dimensionScale();
+}
+template<typename T>
+void BasicUnitGroup<T>::replaceDimensionalUnits(const CrossClassRoute& route, int unit_index) {
+    UnitTable units;
+    
+    units.insert(route.unit_class, unit_index, route.exponent);
+    if ( route.rest_class != -1 ) {
+        units.insert(route.rest_class, unit_classes[route.rest_class].si_unit, route.rest_exponent);
+    }
+    replaceDimensionalUnits(units);
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Sum Units. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup UnitGroup::pow(double exponent) const {
- #ifdef UV_USE_LONG_DOUBLE
-    double_uv new_val = ::powl(_val, exponent);
- #else   
-    double_uv new_val = ::pow(_val, exponent);
-#endif
-    MAP_ATOMIC_UNITS new_units = this->_units;
+template<typename T>
+BasicUnitGroup<T> BasicUnitGroup<T>::pow(double exponent) const {
+    BasicUnitGroup<T> new_group(*this);
+    new_group._val = std::pow(_val, exponent);
     
-    for(MAP_ATOMIC_UNITS::iterator iter = new_units.begin();
-        iter != new_units.end();
-        ++iter)
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
     {
-        iter->second->exponent = iter->second->exponent * exponent;
+        if ( new_group._units.contains(unit_class) ) {
+            new_group._units[unit_class].exponent *= exponent;
+        }
     }
     
-    return UnitGroup(new_val, this->_oper, new_units);
+    return new_group;
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Round to number of digits. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup UnitGroup::roundTo(unsigned int num_of_digits) const {
-#ifdef UV_USE_LONG_DOUBLE   
-    double_uv top = log10l(fabs(this->_val));
-    double_uv cutoff = ::powl(10, int(num_of_digits-top-1));
-#else
-    double_uv top = log10(fabs(this->_val));
-    double_uv cutoff = ::pow(10, int(num_of_digits-top-1));
-#endif
+template<typename T>
+BasicUnitGroup<T> BasicUnitGroup<T>::roundTo(unsigned int num_of_digits) const {
+    T value = getValue();
+    T top = std::log10(std::fabs(value));
+    T cutoff = std::pow((T)10, int(num_of_digits-top-1));
     
     
-    double_uv val = ::round(this->_val*cutoff)/cutoff;
+    T val = std::round(value*cutoff)/cutoff;
     
-    return UnitGroup(val, this->_oper, this->_units);
+    return BasicUnitGroup<T>(val, this->_oper, this->_units);
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Group Comparison. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-bool UnitGroup::operator==(const UnitGroup& unit) const
+template<typename T>
+bool BasicUnitGroup<T>::operator==(const BasicUnitGroup<T>& unit) const
 {
     return unit.areUnitsEqual(this->_units);
 }
@@ -638,10 +1132,12 @@ bool UnitGroup::operator==(const UnitGroup& unit) const
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup UnitGroup::operator*(const UnitGroup& unit) const {
-    UnitGroup new_group = *this;
+template<typename T>
+BasicUnitGroup<T> BasicUnitGroup<T>::operator*(const BasicUnitGroup<T>& unit) const {
+    BasicUnitGroup<T> new_group = *this;
     
     new_group.foldInUnit('*', unit);
+    new_group.reduceProduct();
     
     return new_group;
 }
@@ -650,10 +1146,11 @@ UnitGroup UnitGroup::operator*(const UnitGroup& unit) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup UnitGroup::operator*(const double_uv& val) const {
-    UnitGroup new_group(*this);
+template<typename T>
+BasicUnitGroup<T> BasicUnitGroup<T>::operator*(const T& val) const {
+    BasicUnitGroup<T> new_group(*this);
     
-    new_group.foldInUnit('*', UnitGroup(val, nullptr));
+    new_group.foldInUnit('*', BasicUnitGroup<T>(val, nullptr));
     
     return new_group;
 }
@@ -662,9 +1159,11 @@ UnitGroup UnitGroup::operator*(const double_uv& val) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup& UnitGroup::operator*=(const UnitGroup& unit)
+template<typename T>
+BasicUnitGroup<T>& BasicUnitGroup<T>::operator*=(const BasicUnitGroup<T>& unit)
 {
     this->foldInUnit('*', unit);
+    this->reduceProduct();
     
     return *this;
 }
@@ -673,10 +1172,12 @@ UnitGroup& UnitGroup::operator*=(const UnitGroup& unit)
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup UnitGroup::operator/(const UnitGroup& unit) const {
-    UnitGroup new_group = *this;
+template<typename T>
+BasicUnitGroup<T> BasicUnitGroup<T>::operator/(const BasicUnitGroup<T>& unit) const {
+    BasicUnitGroup<T> new_group = *this;
     
     new_group.foldInUnit('/', unit);
+    new_group.reduceProduct();
     
     return new_group;
 }
@@ -685,10 +1186,11 @@ UnitGroup UnitGroup::operator/(const UnitGroup& unit) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup UnitGroup::operator/(const double_uv& val) const {
-    UnitGroup new_group(*this);
+template<typename T>
+BasicUnitGroup<T> BasicUnitGroup<T>::operator/(const T& val) const {
+    BasicUnitGroup<T> new_group(*this);
     
-    new_group.foldInUnit('*', UnitGroup(1/val, nullptr));
+    new_group.foldInUnit('*', BasicUnitGroup<T>(1/val, nullptr));
     
     return new_group;
 }
@@ -697,8 +1199,10 @@ UnitGroup UnitGroup::operator/(const double_uv& val) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup& UnitGroup::operator/=(const UnitGroup& unit) {
+template<typename T>
+BasicUnitGroup<T>& BasicUnitGroup<T>::operator/=(const BasicUnitGroup<T>& unit) {
     this->foldInUnit('/', unit);
+    this->reduceProduct();
     
     return *this;
 }
@@ -707,8 +1211,9 @@ UnitGroup& UnitGroup::operator/=(const UnitGroup& unit) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup UnitGroup::operator+(const UnitGroup& unit) const {
-    UnitGroup new_group = *this;
+template<typename T>
+BasicUnitGroup<T> BasicUnitGroup<T>::operator+(const BasicUnitGroup<T>& unit) const {
+    BasicUnitGroup<T> new_group = *this;
     new_group.sumUnits('+', unit);
     
     return new_group;
@@ -718,7 +1223,8 @@ UnitGroup UnitGroup::operator+(const UnitGroup& unit) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup& UnitGroup::operator+=(const UnitGroup& unit) {
+template<typename T>
+BasicUnitGroup<T>& BasicUnitGroup<T>::operator+=(const BasicUnitGroup<T>& unit) {
     this->sumUnits('+', unit);
     
     return *this;
@@ -728,8 +1234,9 @@ UnitGroup& UnitGroup::operator+=(const UnitGroup& unit) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup UnitGroup::operator-(const UnitGroup& unit) const {
-    UnitGroup new_group = *this;
+template<typename T>
+BasicUnitGroup<T> BasicUnitGroup<T>::operator-(const BasicUnitGroup<T>& unit) const {
+    BasicUnitGroup<T> new_group = *this;
     
     new_group.sumUnits('-', unit);
     
@@ -740,7 +1247,8 @@ UnitGroup UnitGroup::operator-(const UnitGroup& unit) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup& UnitGroup::operator-=(const UnitGroup& unit) {
+template<typename T>
+BasicUnitGroup<T>& BasicUnitGroup<T>::operator-=(const BasicUnitGroup<T>& unit) {
     this->sumUnits('-', unit);
     
     return *this;
@@ -750,7 +1258,8 @@ UnitGroup& UnitGroup::operator-=(const UnitGroup& unit) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-bool UnitGroup::operator!=(const UnitGroup& unit) const {
+template<typename T>
+bool BasicUnitGroup<T>::operator!=(const BasicUnitGroup<T>& unit) const {
     return !(*this==unit);
 }
 ///-------------------------------------------------------------------------------------------------
@@ -758,30 +1267,226 @@ bool UnitGroup::operator!=(const UnitGroup& unit) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UnitGroup UnitGroup::operator[](const char * pszNewUnits) const {
-    UnitGroup ng(*this);
-    double_uv val_in = _val;
-    for(MAP_ATOMIC_UNITS::const_iterator iter = ng.getUnits().begin();
-        iter != ng.getUnits().end();
-        ++iter)
+template<typename T>
+BasicUnitGroup<T> BasicUnitGroup<T>::operator[](const char * pszNewUnits) const {
+    BasicUnitGroup<T> ng(*this);
+    
+    ng.convertTo(pszNewUnits);
+    
+    return ng;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Group convert to units in place. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+bool BasicUnitGroup<T>::convertTo(const char * units, UnitTargetError * error) {
+    UnitTargetError ret = eTargetOk;
+    
+    if ( !units || (ret = convertHeld(units)) == eTargetUnknownUnit ) {
+        const UnitTarget * target = nullptr;
+        UnitTarget scratch;
+        ret = units ? cachedUnitTarget(units, target, scratch) : eTargetEmpty;
+        if ( ret == eTargetOk ) {
+            ret = convertToTarget(*target);
+        }
+    }
+    if ( error ) {
+        *error = ret;
+    }
+    
+    return ( ret == eTargetOk );
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Group convert the classes held that have the unit abbrev. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             The common case of one abbrev., looked up in the classes held only.
+///             eTargetUnknownUnit if none of them has it, so the caller parses the units, and
+///             eTargetMismatch if the units could not be converted (i.e. C^2 to F). </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+UnitTargetError BasicUnitGroup<T>::convertHeld(std::string_view unit) {
+    short unit_index[eUnitClassCount];
+    unsigned int covered = 0;
+    
+    int unit_class = 0;
+    for(unsigned int classes = _units.mask(); classes; classes >>= 1, ++unit_class)
     {
-        AtomicUnit *au = (*iter).second;
-        int index = (*au)[pszNewUnits];
-        if ( index != -1 ) {
-            if ( au->convert(val_in, index) ) {
-                ng.setValue(val_in);
+        if ( classes & 1 ) {
+            unit_index[unit_class] = (short)unitIndexInClass(unit_class, unit);
+            if ( unit_index[unit_class] != -1 ) {
+                covered |= (1u << unit_class);
             }
         }
     }
+    if ( !covered ) {
+        return eTargetUnknownUnit;
+    }
     
-    return ng;
+    return convertClasses(unit_index, covered) ? eTargetOk : eTargetMismatch;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Group convert to the units of a parsed unit target. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+UnitTargetError BasicUnitGroup<T>::convertToTarget(const UnitTarget& target) {
+    const unsigned int held = _units.mask();
+    const unsigned int dimensional = dimensionalClassMask();
+    
+    // the target vector - one unit per class
+    UnitTable units;
+    UnitTargetError ret = units.fromTarget(target, held);
+    if ( ret != eTargetOk ) {
+        return ret;
+    }
+    
+    // the classes held, each to the power held
+    bool same_units = ( units.mask() == held );
+    short unit_index[eUnitClassCount];
+    for(int unit_class = 0; same_units && unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( held & (1u << unit_class) ) {
+            same_units = ( units[unit_class].exponent == _units[unit_class].exponent );
+            unit_index[unit_class] = units[unit_class].cur_index;
+        }
+    }
+    if ( same_units ) {
+        return convertClasses(unit_index, held) ? eTargetOk : eTargetMismatch;
+    }
+    
+    // otherwise units with the dimensions of the group (i.e. of other classes)
+    long long key;
+    if ( !(held & dimensional) || (units.mask() & ~dimensional) || !_units.dimensionKey(key, dimensional) ) {
+        return eTargetMismatch;
+    }
+    if ( target.factors_len == 1 && target.factors[0].exponent == 1 ) {
+        // one unit - a power of it, or it times the rest of the dimensions (i.e. W-h is W*s)
+        int unit_class = 0;
+        while ( !units.contains(unit_class) ) {
+            ++unit_class;
+        }
+        CrossClassRoute route;
+        if ( !crossClassRoute(key, unit_class, route) ) {
+            return eTargetMismatch;
+        }
+        replaceDimensionalUnits(route, units[unit_class].cur_index);
+        return eTargetOk;
+    }
+    long long target_key;
+    if ( !units.dimensionKey(target_key, dimensional) || target_key != key ) {
+        return eTargetMismatch;
+    }
+    replaceDimensionalUnits(units);
+    
+    return eTargetOk;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Group convert the units of the classes in covered to unit_index of each. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             Linear classes with no parameters are compiled into one factor for all of them.
+///             A group with an affine or log class, or with parameters, converts one class at
+///             a time in class order, as the order of an offset and a scale matters. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+bool BasicUnitGroup<T>::convertClasses(const short unit_index[eUnitClassCount], unsigned int covered) {
+    int unit_class = 0;
+    for(unsigned int classes = covered; classes; classes >>= 1, ++unit_class)
+    {
+        if ( (classes & 1) && !storedInDefaultUnit(unit_class)
+             && (unit_classes[unit_class].engine_kind != eEngineLinear || _units[unit_class].params_len) ) {
+            return convertClassesInOrder(unit_index, covered);
+        }
+    }
+    
+    T factor = 1;
+    unit_class = 0;
+    for(unsigned int classes = covered; classes; classes >>= 1, ++unit_class)
+    {
+        if ( !(classes & 1) || storedInDefaultUnit(unit_class) ) {
+            continue;
+        }
+        // the cached plan of a unit, or a power of it
+        const UnitSlot& au = _units[unit_class];
+        ConversionPlan power_plan;
+        const bool is_power = ( au.exponent != 1 );
+        if ( is_power ) {
+            makeExponentPlan(power_plan, unit_class, au.cur_index, unit_index[unit_class], au.exponent);
+        }
+        const ConversionPlan& plan = is_power ? power_plan : conversionPlan(unit_class, au.cur_index, unit_index[unit_class]);
+        UV_COUNT_CONVERSION(unit_class, au.cur_index, unit_index[unit_class], 1, plan.kind == ePlanInvalid ? 1 : 0);
+        if ( plan.kind == ePlanInvalid ) {
+            return false;
+        }
+        if ( plan.kind == ePlanScale ) {
+            factor *= (T)plan.scale;
+        }
+    }
+    
+    unit_class = 0;
+    for(unsigned int classes = covered; classes; classes >>= 1, ++unit_class)
+    {
+        if ( classes & 1 ) {
+            // only the units shown change under UV_CANONICAL_STORAGE
+            _units[unit_class].cur_index = unit_index[unit_class];
+        }
+    }
+    _val *= factor;
+    
+    return true;
+}
+template<typename T>
+bool BasicUnitGroup<T>::convertClassesInOrder(const short unit_index[eUnitClassCount], unsigned int covered) {
+    bool ret = true;
+    
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( covered & (1u << unit_class) ) {
+            ret = convertUnit(unit_class, unit_index[unit_class]) && ret;
+        }
+    }
+    
+    return ret;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Group convert the unit of unit_class to unit index unit_index in place. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+bool BasicUnitGroup<T>::convertUnit(int unit_class, int unit_index) {
+    if ( unit_class < 0 || unit_class >= eUnitClassCount || !_units.contains(unit_class) ) {
+        return false;
+    }
+
+    UnitSlot& au = _units[unit_class];
+    if ( storedInDefaultUnit(unit_class) ) {
+        // only the units shown change
+        au.cur_index = (short)unit_index;
+        return true;
+    }
+
+    T val_in = _val;
+    if ( !convertWithExponent(unit_class, unit_classes[unit_class].conversion, val_in, au.exponent,
+                              au.cur_index, unit_index, au.params, au.params_len) ) {
+        return false;
+    }
+    au.cur_index = (short)unit_index;
+    _val = val_in;
+
+    return true;
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Group Get Units List. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-const MAP_ATOMIC_UNITS& UnitGroup::getUnits(void) const {
+template<typename T>
+const UnitTable& BasicUnitGroup<T>::getUnits(void) const {
     return _units;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -789,8 +1494,8 @@ const MAP_ATOMIC_UNITS& UnitGroup::getUnits(void) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void UnitGroup::setUnits(const MAP_ATOMIC_UNITS &units) {
-    deleteAllUnits();
+template<typename T>
+void BasicUnitGroup<T>::setUnits(const UnitTable &units) {
     _units = units;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -798,23 +1503,26 @@ void UnitGroup::setUnits(const MAP_ATOMIC_UNITS &units) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-double_uv UnitGroup::getValue(void) const {
-    return _val;
+template<typename T>
+T BasicUnitGroup<T>::getValue(void) const {
+    return fromStored(_val);
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Group Set Value. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void UnitGroup::setValue(double_uv value) {
-    _val = value;
+template<typename T>
+void BasicUnitGroup<T>::setValue(T value) {
+    _val = toStored(value);
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Group Get Oper. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-char UnitGroup::getOper(void) const {
+template<typename T>
+char BasicUnitGroup<T>::getOper(void) const {
     return _oper;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -822,7 +1530,8 @@ char UnitGroup::getOper(void) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void UnitGroup::setOper(char oper) {
+template<typename T>
+void BasicUnitGroup<T>::setOper(char oper) {
     _oper = oper;
 }
     
@@ -831,98 +1540,121 @@ void UnitGroup::setOper(char oper) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void UnitGroup::deleteUnit(std::string id) {
-    if ( _units.count(id) == 1 ) {
-        AtomicUnit * unit = _units[id];
-        
-        if ( unit ) {
-            delete unit;
-        }
-        
-        _units.erase(id);
-    }
+template<typename T>
+void BasicUnitGroup<T>::deleteUnit(int unit_class) {
+    _units.erase(unit_class);
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Group Delete All Contained Units. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void UnitGroup::deleteAllUnits(void) {
-    for(MAP_ATOMIC_UNITS::iterator iter = _units.begin();
-        _units.size() && iter != _units.end();
-        ++iter) {
-        
-        if ( (*iter).second != nullptr ) {
-            delete (*iter).second;
-        }
-    }
-    
+template<typename T>
+void BasicUnitGroup<T>::deleteAllUnits(void) {
     _units.clear();
 }
 
 // end UnitGroup
 
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Unit Group << operator. </summary>
+/// <summary>	Unit classes in the order their units are printed. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             Sorted by class name, the order the units of a Unit Group were kept in when
+///             they were mapped by name, so kg*m/s^2 still prints as (mkg)/(s^2). </remarks>
+///-------------------------------------------------------------------------------------------------
+static const int * unitPrintOrder(void)
+{
+	static const std::array<int, eUnitClassCount> order = [] {
+		std::array<int, eUnitClassCount> classes;
+		for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class) {
+			classes[unit_class] = unit_class;
+		}
+		std::sort(classes.begin(), classes.end(), [](int a, int b) {
+			return strcmp(unit_classes[a].name, unit_classes[b].name) < 0;
+		});
+		return classes;
+	}();
+	return order.data();
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Print the units of the Unit Group whose exponents have the requested sign. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-std::ostream& operator<<(std::ostream& out, const UnitGroup& units)
+static void printUnitSlots(std::ostream& out, const UnitTable& units, bool numerator)
 {
-	const MAP_ATOMIC_UNITS& aunits = units.getUnits();
-	MAP_ATOMIC_UNITS numerator, denominator;
-    
-	for(MAP_ATOMIC_UNITS::const_iterator iter = aunits.begin();
-		iter != aunits.end();
-		++iter)
+	const int * order = unitPrintOrder();
+	for(int i = 0; i < eUnitClassCount; ++i)
 	{
-		if ( (*iter).second->exponent > 0 ) {
-			numerator[(*iter).second->getName()] = ((*iter).second)->clone();
+		const int unit_class = order[i];
+		if ( !units.contains(unit_class) || (units[unit_class].exponent > 0) != numerator ) {
+			continue;
+		}
+
+		const char * cur_unit = units.symbol(unit_class);
+		double exponent = units[unit_class].exponent;
+
+		if ( strchr(cur_unit, ' ') != nullptr ) {
+			out << "(" << cur_unit << ")";
 		}
 		else {
-			denominator[(*iter).second->getName()] = ((*iter).second)->clone();
+			out << cur_unit;
+		}
+
+		// the sign is shown by the side of the quotient the unit is printed on
+		if ( fabs(exponent) != 1 ) {
+			out << AtomicUnit::exponentChar << fabs(exponent);
 		}
 	}
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Group << operator. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+std::ostream& operator<<(std::ostream& out, const BasicUnitGroup<T>& units)
+{
+	const UnitTable& aunits = units.getUnits();
+	bool fIsNum = false;
+	bool fIsDenom = false;
     
-	bool fIsDenom = (denominator.size() > 0);
+	for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+	{
+		if ( aunits.contains(unit_class) ) {
+			if ( aunits[unit_class].exponent > 0 ) {
+				fIsNum = true;
+			}
+			else {
+				fIsDenom = true;
+			}
+		}
+	}
     
-	if ( numerator.size() ) {
+	if ( fIsNum ) {
 		if ( fIsDenom ) {
 			out << "(";
 		}
         
-		for(MAP_ATOMIC_UNITS::const_iterator iter = numerator.begin();
-			iter != numerator.end();
-			++iter)
-		{
-			out << (AtomicUnit *)((*iter).second);
-			delete (*iter).second;
-		}
-        
-		numerator.clear();
+		printUnitSlots(out, aunits, true);
         
 		if ( fIsDenom ) {
 			out << ")";
 		}
-	} // if ( numerator.size() )
+	} // if ( fIsNum )
 	else {
-		if ( denominator.size() ) {
+		if ( fIsDenom ) {
 			out << "1" ;
 		}
 	}
     
-	if ( denominator.size() ) {
+	if ( fIsDenom ) {
 		out << "/(";
         
-		for(MAP_ATOMIC_UNITS::const_iterator iter = denominator.begin();
-			iter != denominator.end();
-			++iter)
-		{
-			out << (AtomicUnit *)((*iter).second);
-			delete (*iter).second;
-		}
-        
-		denominator.clear();
+		printUnitSlots(out, aunits, false);
         
 		out << ")";
 	}
@@ -931,18 +1663,205 @@ std::ostream& operator<<(std::ostream& out, const UnitGroup& units)
 };
 
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Unit Value Container - Contains polynomial of unit values contained
-//              in unit groups. </summary>
+/// <summary>	Reducer Destructor. </summary>
+///
+/// <remarks>	Michael Ryan, 4/25/2016. </remarks>
+///-------------------------------------------------------------------------------------------------
+Reducer::~Reducer()
+{
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Reducer reduce the Unit Group of the rule by the rule. </summary>
+///
+/// <remarks>	Michael Ryan, 4/25/2016. </remarks>
+///-------------------------------------------------------------------------------------------------
+UnitGroup& Reducer::reduce()
+{
+    return parent.reduce(nullptr, *this);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Reducer unit of a dimension - the SI unit of the unit class with the dimension. </summary>
+///
+/// <remarks>	Michael Ryan, 4/25/2016. </remarks>
+///-------------------------------------------------------------------------------------------------
+bool Reducer::derivedUnit(long long dimension_key, int& unit_class, int& unit_index) const
+{
+    unit_class = unitClassOfDimension(dimension_key);
+    unit_index = ( unit_class >= 0 ) ? unit_classes[unit_class].si_unit : -1;
+
+    return ( unit_class >= 0 );
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Container - Contains polynomial of unit values contained
+//              in unit groups. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+
+// pairs of terms below which matching like terms is a plain loop
+#define TERM_INDEX_MIN_PAIRS                        64
+
+// relative difference of values equal but for the rounding of conversion factors, which
+// are doubles (or of T if that is coarser) - canonical storage rounds values of the same
+// units apart as well
+#define CONVERTED_VALUE_TOLERANCE(T)                (8*std::max<T>(std::numeric_limits<T>::epsilon(), \
+                                                                   (T)std::numeric_limits<double>::epsilon()))
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Term Index - open addressed index of the terms of a Unit Value by the
+///             signatureHash of their units. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             Like terms have the same hash, so matching a term is one probe sequence
+///             instead of a pass over every term. </remarks>
+///-------------------------------------------------------------------------------------------------
+class TermIndex
+{
+private:
+    // hash of the term and its index + 1 (0 for an empty slot)
+    std::vector<std::pair<unsigned int, size_t> > _slots;
+    size_t _mask;
+public:
+    // an empty index with room for count terms
+    explicit TermIndex(size_t count) {
+        size_t buckets = 4;
+        while ( buckets < 2*count ) {
+            buckets <<= 1;
+        }
+        _slots.assign(buckets, std::pair<unsigned int, size_t>(0, 0));
+        _mask = buckets - 1;
+    }
+    template<typename G>
+    TermIndex(const TermList<G>& terms, size_t count) : TermIndex(count) {
+        for(size_t i = 0; i < count; ++i)
+        {
+            add(terms[i].getUnits(), i);
+        }
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Term Index adds the term at index with units.  No more terms are added than the
+    ///             count the index was made for. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    void add(const UnitTable& units, size_t index) {
+        unsigned int hash = units.signatureHash();
+        size_t pos = hash & _mask;
+        while ( _slots[pos].second ) {
+            pos = (pos + 1) & _mask;
+        }
+        _slots[pos] = std::pair<unsigned int, size_t>(hash, index + 1);
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Term Index calls match(index) for each term with units of the same hash. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename F>
+    void forEach(const UnitTable& units, F match) const {
+        unsigned int hash = units.signatureHash();
+        for(size_t pos = hash & _mask; _slots[pos].second; pos = (pos + 1) & _mask)
+        {
+            if ( _slots[pos].first == hash ) {
+                match(_slots[pos].second - 1);
+            }
+        }
+    }
+};
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Default Constructor. </summary>
+///
+/// <remarks>	Michael Ryan, 5/09/2014. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValue<T>::BasicUValue(void) : _exponent(1) {};
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Constructor. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         init_val - initial value
+///         unit - Unit pointer (Unit Value will manage this object from now on.  Do not delete.)
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValue<T>::BasicUValue(T init_val, AtomicUnit * unit)
+    : _exponent(1)
+{
+    _units.push_back(BasicUnitGroup<T>(init_val, unit));
+    if ( unit ) {
+        unit->destroy();
+    }
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Constructor from a unit value. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         init_val - initial value
+///         unit - unit (copied, nothing is allocated)
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValue<T>::BasicUValue(T init_val, const AtomicUnit& unit)
+    : _exponent(1)
+{
+    _units.push_back(BasicUnitGroup<T>(init_val, unit));
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Constructor from a unit index. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         init_val - initial value (NaN if the unit index is not in the unit class)
+///         unit_class - unit class
+///         unit_index - index of the unit in the class's units
+///         exponent - exponent of the unit
+/// </parameters>
 ///-------------------------------------------------------------------------------------------------
-
+template<typename T>
+BasicUValue<T>::BasicUValue(T init_val, UnitClassId unit_class, int unit_index, double exponent)
+    : BasicUValue(init_val, UnitRecord{ (short)unit_class, (short)unit_index, exponent })
+{
+}
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Unit Value Default Constructor. </summary>
+/// <summary>	Unit Value Constructor from a Unit Record. </summary>
 ///
-/// <remarks>	Michael Ryan, 5/09/2014. </remarks>
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         init_val - initial value (NaN if the record is not a unit of a unit class)
+///         unit - unit record
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValue<T>::BasicUValue(T init_val, const UnitRecord& unit)
+    : _exponent(1)
+{
+    UnitTable units;
+    if ( unit.unit_class >= 0 && unit.unit_class < eUnitClassCount
+         && unit.index >= 0 && unit.index < unit_classes[unit.unit_class].units_len ) {
+        units.insert(unit.unit_class, unit.index, unit.exponent);
+    }
+    else {
+        init_val = NAN;
+    }
+    _units.push_back(BasicUnitGroup<T>(init_val, 0, units));
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Constructor from a unit expression. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         init_val - initial value (NaN if units can not be parsed)
+///         units - unit expression
+/// </parameters>
 ///-------------------------------------------------------------------------------------------------
-UValue::UValue(void) : _exponent(1) {};
+template<typename T>
+BasicUValue<T>::BasicUValue(T init_val, std::string_view units)
+    : _exponent(1)
+{
+    _units.push_back(BasicUnitGroup<T>(init_val, units));
+}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Constructor. </summary>
 ///
@@ -950,12 +1869,17 @@ UValue::UValue(void) : _exponent(1) {};
 /// <parameters>
 ///         init_val - initial value
 ///         unit - Unit pointer (Unit Value will manage this object from now on.  Do not delete.)
+///         resource - memory resource of the terms (must outlive the Unit Value)
 /// </parameters>
 ///-------------------------------------------------------------------------------------------------
-UValue::UValue(double_uv init_val, AtomicUnit * unit)
-    : _exponent(1)
+template<typename T>
+BasicUValue<T>::BasicUValue(T init_val, AtomicUnit * unit, std::pmr::memory_resource * resource)
+    : _units(resource), _exponent(1)
 {
-    _units.push_back(UnitGroup(init_val, unit));
+    _units.push_back(BasicUnitGroup<T>(init_val, unit));
+    if ( unit ) {
+        unit->destroy();
+    }
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Constructor. </summary>
@@ -966,7 +1890,8 @@ UValue::UValue(double_uv init_val, AtomicUnit * unit)
 ///         unit - Unit pointer (Unit Value will manage this object from now on.  Do not delete.)
 /// </parameters>
 ///-------------------------------------------------------------------------------------------------
-UValue::UValue(double_uv init_val, const LIST_UNIT_GROUP &group_in)
+template<typename T>
+BasicUValue<T>::BasicUValue(T init_val, const UnitGroupList &group_in)
     : _exponent(1) {
     _units = group_in;
     (*_units.begin()).setValue(init_val);
@@ -977,12 +1902,32 @@ UValue::UValue(double_uv init_val, const LIST_UNIT_GROUP &group_in)
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue::UValue(const UValue& val_in)
-    :_exponent(1) {
-    const LIST_UNIT_GROUP& units_in = val_in.getUnits();
-    
-    this->_units.clear();
-    this->_units = units_in;
+template<typename T>
+BasicUValue<T>::BasicUValue(const BasicUValue<T>& val_in)
+    :_units(val_in._units), _exponent(1) {
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Copy Constructor allocating from a memory resource. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Move Constructor. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValue<T>::BasicUValue(const BasicUValue<T>& val_in, std::pmr::memory_resource * resource)
+    :_units(val_in._units, resource), _exponent(1) {
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Move Constructor. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValue<T>::BasicUValue(BasicUValue<T>&& val_in) noexcept
+    :_units(std::move(val_in._units)), _exponent(1) {
 }
     
 ///-------------------------------------------------------------------------------------------------
@@ -990,8 +1935,9 @@ UValue::UValue(const UValue& val_in)
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue::UValue(const LIST_UNIT_GROUP units_in, double exponent)
-    :_exponent(exponent), _units(units_in)
+template<typename T>
+BasicUValue<T>::BasicUValue(const UnitGroupList& units_in, double exponent)
+    : _units(units_in, units_in.resource()), _exponent(exponent)
 {
 }
 ///-------------------------------------------------------------------------------------------------
@@ -999,7 +1945,8 @@ UValue::UValue(const LIST_UNIT_GROUP units_in, double exponent)
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue::~UValue(void)
+template<typename T>
+BasicUValue<T>::~BasicUValue(void)
 {
     deleteAllUnits();
 }
@@ -1008,7 +1955,8 @@ UValue::~UValue(void)
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-size_t UValue::numberOfTerms(void) const
+template<typename T>
+size_t BasicUValue<T>::numberOfTerms(void) const
 {
     return _units.size();
 }
@@ -1017,12 +1965,11 @@ size_t UValue::numberOfTerms(void) const
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-double_uv UValue::getValue(size_t termIndex) const {
-    double_uv value = 0;
+template<typename T>
+T BasicUValue<T>::getValue(size_t termIndex) const {
+    T value = 0;
     if ( termIndex < _units.size() ) {
-        LIST_UNIT_GROUP::const_iterator iter = _units.begin();
-        std::advance(iter, termIndex);
-        value = (*iter).getValue();
+        value = _units[termIndex].getValue();
     }
     
     return value;
@@ -1032,10 +1979,11 @@ double_uv UValue::getValue(size_t termIndex) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-std::list<double_uv> UValue::getValues(void) const
+template<typename T>
+std::list<T> BasicUValue<T>::getValues(void) const
 {
-	std::list<double_uv> values;
-    for( LIST_UNIT_GROUP::const_iterator iter = _units.begin();
+	std::list<T> values;
+    for( typename UnitGroupList::const_iterator iter = _units.begin();
         iter != _units.end();
         ++iter)
     {
@@ -1049,7 +1997,8 @@ std::list<double_uv> UValue::getValues(void) const
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void UValue::setValue(double_uv val)
+template<typename T>
+void BasicUValue<T>::setValue(T val)
 {
     (*_units.begin()).setValue(val);
 }
@@ -1058,16 +2007,25 @@ void UValue::setValue(double_uv val)
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-const char *const UValue::getUnit(void)
+template<typename T>
+const char * BasicUValue<T>::getUnit(void)
 {
-    return (*(*_units.begin()).getUnits().begin()).second->cur_unit;
+    const UnitTable& units = (*_units.begin()).getUnits();
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class) {
+        if ( units.contains(unit_class) ) {
+            return units.symbol(unit_class);
+        }
+    }
+    
+    return scalar[0];
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Get All Unit Groups. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-LIST_UNIT_GROUP UValue::getUnits(void) const
+template<typename T>
+const typename BasicUValue<T>::UnitGroupList& BasicUValue<T>::getUnits(void) const
 {
     //return units;
     return this->_units;
@@ -1077,7 +2035,8 @@ LIST_UNIT_GROUP UValue::getUnits(void) const
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void UValue::setUnits(const LIST_UNIT_GROUP &units) {
+template<typename T>
+void BasicUValue<T>::setUnits(const UnitGroupList &units) {
     this->_units.clear();
     this->_units = units;
 }
@@ -1086,13 +2045,14 @@ void UValue::setUnits(const LIST_UNIT_GROUP &units) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue UValue::roundTo(unsigned int num_of_digits) const {
-    UValue new_value = *this;
+template<typename T>
+BasicUValue<T> BasicUValue<T>::roundTo(unsigned int num_of_digits) const {
+    BasicUValue<T> new_value(*this, getResource());
     
     if ( num_of_digits > 0 )
     {
-        LIST_UNIT_GROUP new_units;
-        for(LIST_UNIT_GROUP::const_iterator iter = this->_units.begin();
+        UnitGroupList new_units;
+        for(typename UnitGroupList::const_iterator iter = this->_units.begin();
             iter != this->_units.end()
             ; ++iter)
         {
@@ -1109,11 +2069,23 @@ UValue UValue::roundTo(unsigned int num_of_digits) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue& UValue::operator=(const UValue& val_in) {
-    const LIST_UNIT_GROUP& units_in = val_in.getUnits();
-    
-    this->_units.clear();
-    this->_units = units_in;
+template<typename T>
+BasicUValue<T>& BasicUValue<T>::operator=(const BasicUValue<T>& val_in) {
+    if ( this != &val_in ) {
+        this->_units = val_in._units;
+    }
+    return *this;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Move = Operator. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValue<T>& BasicUValue<T>::operator=(BasicUValue<T>&& val_in) {
+    if ( this != &val_in ) {
+        this->_units = std::move(val_in._units);
+    }
     return *this;
 }
 ///-------------------------------------------------------------------------------------------------
@@ -1121,25 +2093,41 @@ UValue& UValue::operator=(const UValue& val_in) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-bool UValue::operator==(const UValue& val_in) const {
+template<typename T>
+bool BasicUValue<T>::operator==(const BasicUValue<T>& val_in) const {
     bool ret = false;
-    const LIST_UNIT_GROUP& units_in = val_in.getUnits();
+    const UnitGroupList& units_in = val_in.getUnits();
     
     if ( _units.size() == units_in.size() ) {
         ret = true;
+
+        const size_t num_terms = units_in.size();
+        const bool indexed = ( num_terms*num_terms >= TERM_INDEX_MIN_PAIRS );
+        std::unique_ptr<TermIndex> index(indexed ? new TermIndex(units_in, num_terms) : nullptr);
         
-        for(LIST_UNIT_GROUP::const_iterator self = _units.begin();
+        for(typename UnitGroupList::const_iterator self = _units.begin();
             self != _units.end();
             self++ ) {
             bool found = false;
-            for(LIST_UNIT_GROUP::const_iterator iter = units_in.begin();
-                iter !=  units_in.end();
-                ++iter)
-            {
-                if ( (*iter) == (*self) ) {
-                    if ( (*iter).getValue() == (*self).getValue() ) {
-                        found = true;
-                    }
+            // the value of a like term is compared in the units of this term, to the
+            // precision of the conversion factors
+            auto compare = [&](size_t i) {
+                T value;
+                const T val = (*self)._val;
+                if ( units_in[i] == (*self) && (*self).likeValue(units_in[i], value)
+                     && (value == val
+                         || std::fabs(value - val) <= CONVERTED_VALUE_TOLERANCE(T)*std::fmax(std::fabs(value), std::fabs(val))) ) {
+                    found = true;
+                }
+            };
+
+            if ( indexed ) {
+                index->forEach((*self).getUnits(), compare);
+            }
+            else {
+                for(size_t i = 0; i < num_terms; ++i)
+                {
+                    compare(i);
                 }
             }
             ret &= found;
@@ -1153,7 +2141,8 @@ bool UValue::operator==(const UValue& val_in) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-bool UValue::operator!=(const UValue& val_in) const {
+template<typename T>
+bool BasicUValue<T>::operator!=(const BasicUValue<T>& val_in) const {
     return !(*this==val_in);
 }
 ///-------------------------------------------------------------------------------------------------
@@ -1161,70 +2150,111 @@ bool UValue::operator!=(const UValue& val_in) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue UValue::operator*(const UValue& val) const {
-    UValue new_val = *this;
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator*(const BasicUValue<T>& val) const & {
+    BasicUValue<T> new_val(*this, getResource());
     new_val.foldIntoUnits('*', val);
     return new_val;
 }
+
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator*(const BasicUValue<T>& val) && {
+    foldIntoUnits('*', val);
+    return std::move(*this);
+}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Multiplication double_uv. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue UValue::operator*(const double_uv& val) const {
-    UValue new_value(*this);
-    UValue factor(val);
-    new_value.foldIntoUnits('*', factor);
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator*(const T& val) const & {
+    BasicUValue<T> new_value(*this, getResource());
+    new_value.foldInScalar('*', val);
     return new_value;
 }
+
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator*(const T& val) && {
+    foldInScalar('*', val);
+    return std::move(*this);
+}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Division. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue UValue::operator/(const UValue& val) const {
-    UValue new_val = *this;
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator/(const BasicUValue<T>& val) const & {
+    BasicUValue<T> new_val(*this, getResource());
     new_val.foldIntoUnits('/', val);
     return new_val;
 }
+
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator/(const BasicUValue<T>& val) && {
+    foldIntoUnits('/', val);
+    return std::move(*this);
+}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Division double_uv. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue UValue::operator/(const double_uv& val) const {
-    UValue new_value(*this);
-    UValue factor(val);
-    new_value.foldIntoUnits('/', factor);
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator/(const T& val) const & {
+    BasicUValue<T> new_value(*this, getResource());
+    new_value.foldInScalar('/', val);
     return new_value;
 }
+
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator/(const T& val) && {
+    foldInScalar('/', val);
+    return std::move(*this);
+}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Addition. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue UValue::operator+(const UValue& val) const {
-    UValue new_val = *this;
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator+(const BasicUValue<T>& val) const & {
+    BasicUValue<T> new_val(*this, getResource());
     new_val.sumInUnits('+', val);
     return new_val;
 }
+
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator+(const BasicUValue<T>& val) && {
+    sumInUnits('+', val);
+    return std::move(*this);
+}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Subtraction. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue UValue::operator-(const UValue& val) const {
-    UValue new_val = *this;
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator-(const BasicUValue<T>& val) const & {
+    BasicUValue<T> new_val(*this, getResource());
     new_val.sumInUnits('-', val);
     return new_val;
 }
+
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator-(const BasicUValue<T>& val) && {
+    sumInUnits('-', val);
+    return std::move(*this);
+}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value +=. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue& UValue::operator*=(const UValue& val) {
-    UValue& new_val = *this;
+template<typename T>
+BasicUValue<T>& BasicUValue<T>::operator*=(const BasicUValue<T>& val) {
+    BasicUValue<T>& new_val = *this;
     new_val.foldIntoUnits('*', val);
     return new_val;
 }
@@ -1233,8 +2263,9 @@ UValue& UValue::operator*=(const UValue& val) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue& UValue::operator/=(const UValue& val) {
-    UValue& new_val = *this;
+template<typename T>
+BasicUValue<T>& BasicUValue<T>::operator/=(const BasicUValue<T>& val) {
+    BasicUValue<T>& new_val = *this;
     new_val.foldIntoUnits('/', val);
     return new_val;
 }
@@ -1243,8 +2274,9 @@ UValue& UValue::operator/=(const UValue& val) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue& UValue::operator+=(const UValue& val) {
-    UValue& new_val = *this;
+template<typename T>
+BasicUValue<T>& BasicUValue<T>::operator+=(const BasicUValue<T>& val) {
+    BasicUValue<T>& new_val = *this;
     new_val.sumInUnits('+', val);
     return new_val;
 }
@@ -1253,8 +2285,9 @@ UValue& UValue::operator+=(const UValue& val) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue& UValue::operator-=(const UValue& val) {
-    UValue& new_val = *this;
+template<typename T>
+BasicUValue<T>& BasicUValue<T>::operator-=(const BasicUValue<T>& val) {
+    BasicUValue<T>& new_val = *this;
     new_val.sumInUnits('-', val);
     return new_val;
 }
@@ -1264,14 +2297,14 @@ UValue& UValue::operator-=(const UValue& val) {
  ///
  /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
  ///-------------------------------------------------------------------------------------------------
- bool operator<(const UValue& val) const {
+ bool operator<(const BasicUValue<T>& val) const {
  bool is_less_than = false;
- const LIST_UNIT_GROUP& val_units = val.getUnits();
+ const UnitGroupList& val_units = val.getUnits();
  
- for(LIST_UNIT_GROUP::const_iterator val_iter = val_units.begin();
+ for(typename UnitGroupList::const_iterator val_iter = val_units.begin();
  val_iter != val_units.end();
  ++val_iter) {
- LIST_UNIT_GROUP::const_iterator iter = _units.begin();
+ typename UnitGroupList::const_iterator iter = _units.begin();
  bool are_equal = false;
  for(;
  iter != _units.end() && !are_equal;
@@ -1300,28 +2333,59 @@ UValue& UValue::operator-=(const UValue& val) {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue UValue::operator[](const char * pszNewUnits) const {
-    UValue new_value = *this;
-    LIST_UNIT_GROUP ngroups;
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator[](const char * pszNewUnits) const & {
+    BasicUValue<T> new_value(*this, getResource());
+    return std::move(new_value)[pszNewUnits];
+}
 
-    for(LIST_UNIT_GROUP::const_iterator iter = _units.begin();
-        iter != _units.end();
+template<typename T>
+BasicUValue<T> BasicUValue<T>::operator[](const char * pszNewUnits) && {
+    convertTo(pszNewUnits);
+    
+    return std::move(*this);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value convert each term to units in place. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+bool BasicUValue<T>::convertTo(const char * units, UnitTargetError * error) {
+    const UnitTarget * target = nullptr;
+    UnitTarget scratch;
+    UnitTargetError parsed = eTargetEmpty;
+    UnitTargetError ret = units ? eTargetOk : eTargetEmpty;
+    
+    // looked up once, by the first term that needs it, and every term is converted if it can be
+    for(typename UnitGroupList::iterator iter = _units.begin();
+        units && iter != _units.end();
         ++iter)
     {
-        const UnitGroup& ug = (*iter);
-        ngroups.push_back(ug[pszNewUnits]);
+        UnitTargetError term_ret = iter->convertHeld(units);
+        if ( term_ret == eTargetUnknownUnit ) {
+            if ( !target ) {
+                parsed = cachedUnitTarget(units, target, scratch);
+            }
+            term_ret = ( parsed == eTargetOk ) ? iter->convertToTarget(*target) : parsed;
+        }
+        if ( ret == eTargetOk ) {
+            ret = term_ret;
+        }
+    }
+    if ( error ) {
+        *error = ret;
     }
-
-    new_value.setUnits(ngroups);
     
-    return new_value;
+    return ( ret == eTargetOk );
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value print. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-std::string UValue::print(int precision,
+template<typename T>
+std::string BasicUValue<T>::print(int precision,
                   std::ios::fmtflags notation,
                   std::ios::fmtflags mask ) const {
     std::stringstream out;
@@ -1332,11 +2396,11 @@ std::string UValue::print(int precision,
     }
     
     out << this->getValue() << " ";
-    const LIST_UNIT_GROUP& uni = this->getUnits();
+    const UnitGroupList& uni = this->getUnits();
     bool fFirst = true;
     
     if ( uni.size() ) {
-        for(LIST_UNIT_GROUP::const_iterator iter = uni.begin();
+        for(typename UnitGroupList::const_iterator iter = uni.begin();
             iter != uni.end();
             ++iter)
         {
@@ -1360,16 +2424,17 @@ std::string UValue::print(int precision,
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-std::string UValue::printUnits(void) const {
+template<typename T>
+std::string BasicUValue<T>::printUnits(void) const {
     std::stringstream ss;
     bool fFirst = true;
     
     if ( this->_units.size() ) {
-        for(LIST_UNIT_GROUP::const_iterator iter = this->_units.begin();
+        for(typename UnitGroupList::const_iterator iter = this->_units.begin();
             iter != this->_units.end();
             ++iter)
         {
-            const UnitGroup &ug = *iter;
+            const BasicUnitGroup<T> &ug = *iter;
             if ( !fFirst ) {
                 ss << ug.getOper() << " ";
             }
@@ -1386,63 +2451,134 @@ std::string UValue::printUnits(void) const {
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue UValue::pow(double exponent) const {
-    LIST_UNIT_GROUP new_units = this->_units;
-    int pow_to = (int)exponent;
-    double frac = exponent - pow_to;
-    double new_exponent = 0.0;
+template<typename T>
+BasicUValue<T> BasicUValue<T>::pow(double exponent) const {
+    UnitGroupList new_units(this->_units.resource());
+    // a power of a Unit Value held to a power
+    double total = exponent*this->_exponent;
+    double new_exponent = 1.0;
     
     if ( this->_units.size() > 1 )
     {
-        pow_to *= int(1/this->_exponent);
+        unsigned int pow_to = (unsigned int)std::fabs(total);
         
-        
-        for(int i = 0; i < pow_to; i++)
-        {
-            for(LIST_UNIT_GROUP::iterator iter1 = new_units.begin();
-                iter1 != new_units.end();
-                ++iter1
-                )
+        if ( total == 0 ) {
+            return BasicUValue<T>((T)1);
+        }
+        else if ( pow_to == 0 ) {
+            // a root of a polynomial is not expanded
+            new_units = this->_units;
+            new_exponent = total;
+        }
+        else {
+            // the whole power by squaring, what is left of it held as the exponent
+            UnitGroupList base(this->_units, this->_units.resource());
+            UnitGroupList product(this->_units.resource());
+            bool started = false;
+            
+            for(unsigned int n = pow_to; n; n >>= 1)
             {
-                for(LIST_UNIT_GROUP::const_iterator iter2 = this->_units.begin();
-                    iter2 != this->_units.end();
-                    ++iter2
-                    )
-                {
-                    *iter1 = (*iter1)*(*iter2);
+                if ( n & 1 ) {
+                    if ( started ) {
+                        multiplyTerms(product, new_units, base);
+                        new_units = std::move(product);
+                    }
+                    else {
+                        new_units = base;
+                        started = true;
+                    }
+                }
+                if ( n > 1 ) {
+                    multiplyTerms(product, base, base);
+                    base = std::move(product);
                 }
             }
-        }
-        
-        if ( frac != 0 )
-        {
-            new_exponent = frac;
+            new_exponent = total/pow_to;
         }
     } // if ( this->_units.size() > 1 )
     else if (this->_units.size() == 1)
     {
-        new_units.push_back((this->_units.front()).pow(exponent));
+        new_units.push_back((this->_units.front()).pow(total));
+    }
+    return BasicUValue<T>(new_units, new_exponent);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value with each term reduced. </summary>
+///
+/// <remarks>	Michael Ryan, 4/25/2016. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValue<T> BasicUValue<T>::reduce(const char * units) const {
+    BasicUValue<T> reduced(*this);
+    
+    for(typename UnitGroupList::iterator iter = reduced._units.begin(); iter != reduced._units.end(); ++iter)
+    {
+        (*iter).reduce(units);
+    }
+    
+    return reduced;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value multiply terms - the product of two polynomials with like terms
+///             combined. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012.
+///             A square takes each cross term once and doubles it. </remarks>
+/// <parameters>
+///         product - terms of the product (cleared first)
+///         left - terms of the left factor
+///         right - terms of the right factor, which may be left
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+void BasicUValue<T>::multiplyTerms(UnitGroupList& product, const UnitGroupList& left,
+                                   const UnitGroupList& right)
+{
+    const bool square = ( &left == &right );
+    TermIndex index(square ? left.size()*(left.size() + 1)/2 : left.size()*right.size());
+    product.clear();
+    
+    for(size_t i = 0; i < left.size(); ++i)
+    {
+        for(size_t j = square ? i : 0; j < right.size(); ++j)
+        {
+            BasicUnitGroup<T> term = left[i]*right[j];
+            if ( square && j != i ) {
+                term._val *= 2;
+            }
+            
+            bool merged = false;
+            index.forEach(term.getUnits(), [&](size_t k) {
+                if ( !merged && product[k] == term ) {
+                    product[k] += term;
+                    merged = true;
+                }
+            });
+            
+            if ( !merged ) {
+                index.add(term.getUnits(), product.size());
+                product.push_back(std::move(term));
+            }
+        }
     }
-    return UValue(new_units, new_exponent);
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value fold units. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-bool UValue::foldIntoUnits(char oper, const UValue& val_in, bool simplify)
+template<typename T>
+bool BasicUValue<T>::foldIntoUnits(char oper, const BasicUValue<T>& val_in, bool simplify)
 {
-    const LIST_UNIT_GROUP& unit_in = val_in.getUnits();
+    const UnitGroupList& unit_in = val_in.getUnits();
     bool ret = true;
-    int i = 0;
     
     if ( !_units.empty() && !unit_in.empty() ) {
-        LIST_UNIT_GROUP::iterator * deleteList = new LIST_UNIT_GROUP::iterator[_units.size()];
-        for(LIST_UNIT_GROUP::iterator iter1 = _units.begin();
+        for(typename UnitGroupList::iterator iter1 = _units.begin();
             iter1 != _units.end();
             ++iter1)
         {
-            for(LIST_UNIT_GROUP::const_iterator iter2 = unit_in.begin();
+            for(typename UnitGroupList::const_iterator iter2 = unit_in.begin();
                 iter2 != unit_in.end();
                 ++iter2)
             {
@@ -1455,17 +2591,16 @@ bool UValue::foldIntoUnits(char oper, const UValue& val_in, bool simplify)
 						break;
                 }
                 
-                if ( simplify && (*iter1).getValue() == 0 ) {
-                    deleteList[i++] = iter1;
-                }
             }
         }
         
-        for(;i;i--) {
-            _units.erase(deleteList[i-1]);
+        // terms folded to zero are dropped in place
+        if ( simplify ) {
+            for(typename UnitGroupList::iterator iter = _units.begin(); iter != _units.end();)
+            {
+                iter = ( (*iter)._val == 0 ) ? _units.erase(iter) : iter+1;
+            }
         }
-        
-        delete [] deleteList;
     }
     
     return ret;
@@ -1475,84 +2610,103 @@ bool UValue::foldIntoUnits(char oper, const UValue& val_in, bool simplify)
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-bool UValue::sumInUnits(char oper, const UValue& units_in, bool simplify) {
-    LIST_UNIT_GROUP units_copy = units_in.getUnits();
+template<typename T>
+bool BasicUValue<T>::sumInUnits(char oper, const BasicUValue<T>& units_in, bool simplify) {
+    const UnitGroupList& unit_in = units_in._units;
+    const size_t num_terms = _units.size();
     bool ret = true;
     //bool added = false;
-    double_uv value = 0;
-    
-    int i = 0;
-    LIST_UNIT_GROUP::iterator * deleteList = new LIST_UNIT_GROUP::iterator[units_copy.size()];
-    for(LIST_UNIT_GROUP::iterator iter1 = _units.begin();
-        iter1 != _units.end();
-        ++iter1)
+    T value = 0;
+    
+    // terms of units_in with no like term here are appended, indexed as units_in may be *this
+    const size_t num_terms_in = unit_in.size();
+    // like terms are found through an index of the terms here past a few terms
+    std::unique_ptr<TermIndex> index(( num_terms*num_terms_in >= TERM_INDEX_MIN_PAIRS )
+                                     ? new TermIndex(_units, num_terms) : nullptr);
+    for(size_t i = 0; i < num_terms_in; ++i)
     {
-        for(LIST_UNIT_GROUP::iterator iter2 = units_copy.begin();
-            iter2 != units_copy.end();
-            ++iter2)
-        {
-            if ( (*iter1) == (*iter2) ) {
+        const BasicUnitGroup<T>& term_in = unit_in[i];
+        bool matched = false;
+        auto sumInto = [&](size_t j) {
+            BasicUnitGroup<T>& term = _units[j];
+            if ( term == term_in ) {
                 switch(oper) {
                     case '+':
-						*iter1 += (*iter2);
+						term += term_in;
 						break;
                     case '-':
-						*iter1 -= (*iter2);
+						term -= term_in;
 						break;
                 }
                 
-                value = (*iter1).getValue();
-                
-                deleteList[i++] = iter2;
+                value = term._val;
+                matched = true;
             }
+        };
+
+        if ( index ) {
+            index->forEach(term_in.getUnits(), sumInto);
         }
-    }
-    
-    for(;i;i--) {
-        units_copy.erase(deleteList[i-1]);
-    }
-    
-    delete [] deleteList;
-    
-    if ( (simplify && value != 0)
-        || !simplify ) {
-        if ( _units.size() ) {
-            for(LIST_UNIT_GROUP::iterator iter2 = units_copy.begin();
-                iter2 != units_copy.end();
-                ++iter2) {
-                _units.push_back(*iter2);
-                (*iter2).setOper(oper);
+        else {
+            for(size_t j = 0; j < num_terms; ++j)
+            {
+                sumInto(j);
             }
         }
+        
+        if ( !matched && num_terms ) {
+            _units.push_back(term_in);
+        }
     }
-    else {
+    
+    if ( simplify && value == 0 ) {
         deleteAllUnits();
     }
     
     return ret;
 }
 ///-------------------------------------------------------------------------------------------------
-/// <summary>	Unit Value Delete Unit at Index. </summary>
+/// <summary>	Unit Value scale every term by a unitless value. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void UValue::deleteUnit(int i) {
-    int j = 0;
-    for(LIST_UNIT_GROUP::iterator iter = _units.begin();
-        iter != _units.end() &&  j != i;
-        ++iter, ++j)
+template<typename T>
+void BasicUValue<T>::foldInScalar(char oper, T val)
+{
+    const BasicUnitGroup<T> factor(val);
+    
+    for(typename UnitGroupList::iterator iter = _units.begin();
+        iter != _units.end();
+        ++iter)
     {
-        if ( j == i ) {
-            _units.erase(iter);
+        switch(oper) {
+            case '*':
+                *iter *= factor;
+                break;
+            case '/':
+                *iter /= factor;
+                break;
         }
     }
 }
 ///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Delete Unit at Index. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+void BasicUValue<T>::deleteUnit(int i) {
+    if ( i >= 0 && (size_t)i < _units.size() ) {
+        _units.erase(_units.begin() + i);
+    }
+}
+///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Delete All Units. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-void UValue::deleteAllUnits(void)
+template<typename T>
+void BasicUValue<T>::deleteAllUnits(void)
 {
     _units.clear();
 }
@@ -1563,47 +2717,221 @@ void UValue::deleteAllUnits(void)
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue operator*(double_uv val1, const UValue& val2)
+template<typename T>
+BasicUValue<T> operator*(typename BasicUValue<T>::value_type val1, const BasicUValue<T>& val2)
 {
 	return val2*val1;
 };
+
+template<typename T>
+BasicUValue<T> operator*(typename BasicUValue<T>::value_type val1, BasicUValue<T>&& val2)
+{
+	return std::move(val2)*val1;
+}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Addition. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue operator+(double_uv val1, const UValue& val2)
+template<typename T>
+BasicUValue<T> operator+(typename BasicUValue<T>::value_type val1, const BasicUValue<T>& val2)
 {
 	return val2+val1;
 }
+
+template<typename T>
+BasicUValue<T> operator+(typename BasicUValue<T>::value_type val1, BasicUValue<T>&& val2)
+{
+	return std::move(val2)+val1;
+}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Subtraction. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue operator-(double_uv val1, const UValue& val2)
+template<typename T>
+BasicUValue<T> operator-(typename BasicUValue<T>::value_type val1, const BasicUValue<T>& val2)
 {
 	return (val2*(-1))+val1;
 }
+
+template<typename T>
+BasicUValue<T> operator-(typename BasicUValue<T>::value_type val1, BasicUValue<T>&& val2)
+{
+	return (std::move(val2)*(-1))+val1;
+}
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value Division. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-UValue operator/(double_uv val1, const UValue& val2) {
-	UValue num(1.0);
+template<typename T>
+BasicUValue<T> operator/(typename BasicUValue<T>::value_type val1, const BasicUValue<T>& val2) {
+	BasicUValue<T> num(1.0, nullptr, val2.getResource());
+    
+	return std::move(num)/(val2/val1);
+}
+
+template<typename T>
+BasicUValue<T> operator/(typename BasicUValue<T>::value_type val1, BasicUValue<T>&& val2) {
+	BasicUValue<T> num(1.0, nullptr, val2.getResource());
     
-	return num/(val2/val1);
+	return std::move(num)/(std::move(val2)/val1);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value lazy [] - a view of this Unit Value in other units. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValueView<T> BasicUValue<T>::as(const char * pszNewUnits) const {
+    return BasicUValueView<T>(*this, pszNewUnits);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value View Constructor. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValueView<T>::BasicUValueView(const BasicUValue<T>& source, const char * pszNewUnits)
+    : _source(&source), _classes(0) {
+    for(size_t i = 0; i < source._units.size(); ++i)
+    {
+        _classes |= source._units[i].getUnits().mask();
+    }
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        _targets[unit_class] = -1;
+    }
+    *this = (*this)[pszNewUnits];
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value View [] with unit abbrev. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValueView<T> BasicUValueView<T>::operator[](const char * pszNewUnits) const {
+    BasicUValueView<T> view(*this);
+    if ( !pszNewUnits ) {
+        return view;
+    }
+
+    std::string_view new_units(pszNewUnits);
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( _classes & (1u << unit_class) ) {
+            int index = unitIndexInClass(unit_class, new_units);
+            if ( index != -1 ) {
+                view._targets[unit_class] = (short)index;
+            }
+        }
+    }
+
+    return view;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value View convert a term to the target units. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+void BasicUValueView<T>::applyTargets(BasicUnitGroup<T>& group) const {
+    const UnitTable& units = group.getUnits();
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( _targets[unit_class] != -1 && units.contains(unit_class)
+             && units[unit_class].cur_index != _targets[unit_class] ) {
+            group.convertUnit(unit_class, _targets[unit_class]);
+        }
+    }
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value View Get Polynomial Term in the target units (default is zero). </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+T BasicUValueView<T>::getValue(size_t termIndex) const {
+    if ( termIndex >= _source->_units.size() ) {
+        return 0;
+    }
+
+    BasicUnitGroup<T> term(_source->_units[termIndex]);
+    applyTargets(term);
+
+    return term.getValue();
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value View print. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+std::string BasicUValueView<T>::print(int precision,
+                  std::ios::fmtflags notation,
+                  std::ios::fmtflags mask ) const {
+    return materialize().print(precision, notation, mask);
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value View converted into a Unit Value. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValue<T> BasicUValueView<T>::materialize(void) const {
+    BasicUValue<T> value(*_source, _source->getResource());
+    for(typename BasicUValue<T>::UnitGroupList::iterator iter = value._units.begin();
+        iter != value._units.end();
+        ++iter)
+    {
+        applyTargets(*iter);
+    }
+
+    return value;
+}
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value View <<. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+std::ostream& operator<<(std::ostream& out, const BasicUValueView<T>& view) {
+	return out << view.materialize();
 }
 ///-------------------------------------------------------------------------------------------------
 /// <summary>	Unit Value <<. </summary>
 ///
 /// <remarks>	Michael Ryan, 5/11/2012. </remarks>
 ///-------------------------------------------------------------------------------------------------
-std::ostream& operator<<(std::ostream& out, const UValue& val) {
+template<typename T>
+std::ostream& operator<<(std::ostream& out, const BasicUValue<T>& val) {
     std::string s = val.printUnits();
 	out << val.getValue() << " " << s;
     
 	return out;
 }
 
+
+/*
+ The precisions built into the library
+ */
+#define UVALUE_INSTANTIATE(T)                                                                   \
+template class BasicUnitGroup<T>;                                                               \
+template class BasicUValue<T>;                                                                  \
+template class BasicUValueView<T>;                                                              \
+template std::ostream& operator<< <T>(std::ostream& out, const BasicUValueView<T>& view);       \
+template std::ostream& operator<< <T>(std::ostream& out, const BasicUnitGroup<T>& units);       \
+template std::ostream& operator<< <T>(std::ostream& out, const BasicUValue<T>& val);            \
+template BasicUValue<T> operator* <T>(T val1, const BasicUValue<T>& val2);                      \
+template BasicUValue<T> operator* <T>(T val1, BasicUValue<T>&& val2);                           \
+template BasicUValue<T> operator+ <T>(T val1, const BasicUValue<T>& val2);                      \
+template BasicUValue<T> operator+ <T>(T val1, BasicUValue<T>&& val2);                           \
+template BasicUValue<T> operator- <T>(T val1, const BasicUValue<T>& val2);                      \
+template BasicUValue<T> operator- <T>(T val1, BasicUValue<T>&& val2);                           \
+template BasicUValue<T> operator/ <T>(T val1, const BasicUValue<T>& val2);                      \
+template BasicUValue<T> operator/ <T>(T val1, BasicUValue<T>&& val2);
+
+UVALUE_INSTANTIATE(float)
+UVALUE_INSTANTIATE(double)
+UVALUE_INSTANTIATE(long double)
@@ -0,0 +1,786 @@
+///-------------------------------------------------------------------------------------------------
+// file:	UValueArray.cpp
+//
+// summary:  Defines the BasicUValueArray class - a column of values sharing one unit signature.
+//           Conversions resolve one ConversionPlan per unit class and run over the whole
+//           buffer; linear plans of every class are folded into a single factor first.
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <new>
+#include <vector>
+#include <utility>
+#include "UValueArray.hpp"
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Aligned value buffers. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+static T * allocValues(size_t count)
+{
+    if ( count == 0 ) {
+        return nullptr;
+    }
+
+    UV_COUNT_ALLOCATION(eAllocArray, -1);
+    return static_cast<T *>(::operator new(count*sizeof(T), std::align_val_t(UVALUE_ARRAY_ALIGNMENT)));
+}
+
+template<typename T>
+static void freeValues(T * values)
+{
+    if ( values ) {
+        ::operator delete(values, std::align_val_t(UVALUE_ARRAY_ALIGNMENT));
+    }
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Plan of one unit class raised to exponent, cached unless the unit carries its
+///             own parameters or an exponent other than 1. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+static const ConversionPlan& planFor(int unit_class, int in, int out, double exponent,
+                                     const engine_uv * params_list, size_t params_list_len,
+                                     ConversionPlan& storage)
+{
+    if ( params_list_len > 0 || exponent != 1 ) {
+        makeExponentPlan(storage, unit_class, in, out, exponent, params_list, params_list_len);
+        return storage;
+    }
+
+    return conversionPlan(unit_class, in, out);
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Folds a linear plan into factor. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <returns>   false if the plan is not linear and has to be applied value by value </returns>
+///-------------------------------------------------------------------------------------------------
+static bool foldLinearPlan(const ConversionPlan& plan, engine_uv& factor)
+{
+    switch(plan.kind) {
+        case ePlanIdentity:
+            return true;
+        case ePlanScale:
+            factor *= plan.scale;
+            return true;
+        default:
+            return false;
+    }
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Applies a non-linear plan to count values. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// An invalid plan (i.e. a temperature raised to an exponent) gives NaN values.
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+static void applyPlan(const ConversionPlan& plan, T * values, size_t count)
+{
+    if ( plan.kind == ePlanInvalid ) {
+        for(size_t i = 0; i < count; i++) {
+            values[i] = NAN;
+        }
+        return;
+    }
+
+    applyConversionPlanBulk(plan, values, count);
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Array Constructors. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValueArray<T>::BasicUValueArray(void)
+    : _values(nullptr), _size(0), _capacity(0)
+{
+}
+
+template<typename T>
+BasicUValueArray<T>::BasicUValueArray(size_t count, const AtomicUnit& unit, T init_val)
+    : _values(allocValues<T>(count)), _size(count), _capacity(count)
+{
+    _units = BasicUnitGroup<T>(0, unit).getUnits();
+    for(size_t i = 0; i < _size; i++) {
+        _values[i] = init_val;
+    }
+}
+
+template<typename T>
+BasicUValueArray<T>::BasicUValueArray(const T * values, size_t count, const AtomicUnit& unit)
+    : _values(allocValues<T>(count)), _size(count), _capacity(count)
+{
+    _units = BasicUnitGroup<T>(0, unit).getUnits();
+    for(size_t i = 0; i < _size; i++) {
+        _values[i] = values[i];
+    }
+}
+
+template<typename T>
+BasicUValueArray<T>::BasicUValueArray(size_t count, const BasicUValue<T>& init_val)
+    : _values(allocValues<T>(count)), _size(count), _capacity(count)
+{
+    T value = NAN;
+    if ( init_val.numberOfTerms() == 1 ) {
+        const BasicUnitGroup<T>& term = init_val.getUnits().front();
+        _units = term.getUnits();
+        value = term.getValue();
+    }
+
+    for(size_t i = 0; i < _size; i++) {
+        _values[i] = value;
+    }
+}
+
+template<typename T>
+BasicUValueArray<T>::BasicUValueArray(const BasicUValueArray<T>& array_in)
+    : _units(array_in._units), _values(allocValues<T>(array_in._size))
+    , _size(array_in._size), _capacity(array_in._size)
+{
+    for(size_t i = 0; i < _size; i++) {
+        _values[i] = array_in._values[i];
+    }
+}
+
+template<typename T>
+BasicUValueArray<T>::BasicUValueArray(BasicUValueArray<T>&& array_in) noexcept
+    : _units(array_in._units), _values(array_in._values)
+    , _size(array_in._size), _capacity(array_in._capacity)
+{
+    array_in._values = nullptr;
+    array_in._size = 0;
+    array_in._capacity = 0;
+}
+
+template<typename T>
+BasicUValueArray<T>::~BasicUValueArray(void)
+{
+    freeValues(_values);
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator=(const BasicUValueArray<T>& array_in)
+{
+    if ( this != &array_in ) {
+        if ( _capacity < array_in._size ) {
+            freeValues(_values);
+            _values = allocValues<T>(array_in._size);
+            _capacity = array_in._size;
+        }
+
+        _units = array_in._units;
+        _size = array_in._size;
+        for(size_t i = 0; i < _size; i++) {
+            _values[i] = array_in._values[i];
+        }
+    }
+
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator=(BasicUValueArray<T>&& array_in) noexcept
+{
+    if ( this != &array_in ) {
+        freeValues(_values);
+        _units = array_in._units;
+        _values = array_in._values;
+        _size = array_in._size;
+        _capacity = array_in._capacity;
+
+        array_in._values = nullptr;
+        array_in._size = 0;
+        array_in._capacity = 0;
+    }
+
+    return *this;
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Array element as a Unit Value. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValue<T> BasicUValueArray<T>::at(size_t index) const
+{
+    typename BasicUValue<T>::UnitGroupList group;
+    group.push_back(BasicUnitGroup<T>(_values[index], 0, _units));
+
+    return BasicUValue<T>(_values[index], group);
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Array set element from a single term Unit Value. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+bool BasicUValueArray<T>::set(size_t index, const BasicUValue<T>& val)
+{
+    if ( index >= _size || val.numberOfTerms() != 1 ) {
+        return false;
+    }
+
+    const BasicUnitGroup<T>& term = val.getUnits().front();
+    if ( !_units.sameClasses(term.getUnits()) ) {
+        return false;
+    }
+
+    const UnitTable& units_in = term.getUnits();
+    T value = term.getValue();
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( !_units.contains(unit_class) ) {
+            continue;
+        }
+
+        const UnitSlot& au_in = units_in[unit_class];
+        ConversionPlan storage;
+        const ConversionPlan& plan = planFor(unit_class, au_in.cur_index, _units[unit_class].cur_index,
+                                             au_in.exponent, au_in.params, au_in.params_len, storage);
+        applyPlan(plan, &value, 1);
+    }
+
+    _values[index] = value;
+
+    return true;
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Array buffer management. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+void BasicUValueArray<T>::reserve(size_t capacity)
+{
+    if ( capacity > _capacity ) {
+        T * values = allocValues<T>(capacity);
+        for(size_t i = 0; i < _size; i++) {
+            values[i] = _values[i];
+        }
+
+        freeValues(_values);
+        _values = values;
+        _capacity = capacity;
+    }
+}
+
+template<typename T>
+void BasicUValueArray<T>::resize(size_t count, T val)
+{
+    reserve(count);
+    for(size_t i = _size; i < count; i++) {
+        _values[i] = val;
+    }
+    _size = count;
+}
+
+template<typename T>
+void BasicUValueArray<T>::push_back(T val)
+{
+    if ( _size == _capacity ) {
+        reserve(_capacity ? 2*_capacity : 8);
+    }
+
+    _values[_size++] = val;
+}
+
+template<typename T>
+bool BasicUValueArray<T>::push_back(const BasicUValue<T>& val)
+{
+    push_back(NAN);
+    if ( !set(_size - 1, val) ) {
+        --_size;
+        return false;
+    }
+
+    return true;
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Array [] with unit abbrev. - converts the whole column. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator[](const char * pszNewUnits) const &
+{
+    BasicUValueArray<T> new_array(*this);
+    return std::move(new_array)[pszNewUnits];
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator[](const char * pszNewUnits) &&
+{
+    if ( !pszNewUnits ) {
+        return std::move(*this);
+    }
+
+    std::string_view new_units(pszNewUnits);
+    engine_uv factor = 1.0;
+    std::vector<int> nonlinear;
+
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( !_units.contains(unit_class) ) {
+            continue;
+        }
+
+        UnitSlot& au = _units[unit_class];
+        int index = unitIndexInClass(unit_class, new_units);
+        if ( index == -1 || index == au.cur_index ) {
+            continue;
+        }
+
+        ConversionPlan storage;
+        const ConversionPlan& plan = planFor(unit_class, au.cur_index, index, au.exponent,
+                                             au.params, au.params_len, storage);
+        if ( plan.kind == ePlanInvalid ) {
+            continue;
+        }
+
+        if ( foldLinearPlan(plan, factor) ) {
+            au.cur_index = (short)index;
+        }
+        else {
+            // applied after the linear factor, from the unit in to index
+            nonlinear.push_back(unit_class);
+            nonlinear.push_back(index);
+        }
+    }
+
+    if ( factor != 1.0 ) {
+        const ConversionPlan scale = { ePlanScale, factor, 0, 1 };
+        applyConversionPlanBulk(scale, _values, _size);
+    }
+
+    for(size_t i = 0; i < nonlinear.size(); i += 2)
+    {
+        UnitSlot& au = _units[nonlinear[i]];
+        ConversionPlan storage;
+        const ConversionPlan& plan = planFor(nonlinear[i], au.cur_index, nonlinear[i+1], au.exponent,
+                                             au.params, au.params_len, storage);
+        applyPlan(plan, _values, _size);
+        au.cur_index = (short)nonlinear[i+1];
+    }
+
+    return std::move(*this);
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Array fold in units and values by * or /. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+/// <parameters>
+///         oper - '*' or '/'
+///         units_in - unit signature of values_in
+///         values_in - values to fold in
+///         stride - 1 for a column of size() values or 0 for a single value
+/// </parameters>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+bool BasicUValueArray<T>::foldIn(char oper, const UnitTable& units_in, const T * values_in, size_t stride)
+{
+    BasicUnitGroup<T> signature(1, 0, _units);
+    engine_uv factor = 1.0;
+    std::vector<int> nonlinear;
+
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( !units_in.contains(unit_class) || !_units.contains(unit_class) ) {
+            continue;
+        }
+
+        // values_in are taken into the units of this array with their own parameters
+        const UnitSlot& au_in = units_in[unit_class];
+        const UnitSlot& au = _units[unit_class];
+        ConversionPlan storage;
+        const ConversionPlan& plan = planFor(unit_class, au_in.cur_index, au.cur_index, au_in.exponent,
+                                             au_in.params, au_in.params_len, storage);
+        if ( !foldLinearPlan(plan, factor) ) {
+            nonlinear.push_back(unit_class);
+        }
+    }
+
+    switch(oper) {
+        case '*':
+            signature *= BasicUnitGroup<T>(1, 0, units_in);
+            break;
+        case '/':
+            signature /= BasicUnitGroup<T>(1, 0, units_in);
+            break;
+        default:
+            return false;
+    }
+
+    // only non-linear units (i.e. temperatures) need a converted copy of values_in
+    std::vector<T> converted;
+    if ( !nonlinear.empty() ) {
+        converted.assign(values_in, values_in + (stride ? _size : 1));
+        for(size_t i = 0; i < nonlinear.size(); i++)
+        {
+            const UnitSlot& au_in = units_in[nonlinear[i]];
+            const UnitSlot& au = _units[nonlinear[i]];
+            ConversionPlan storage;
+            const ConversionPlan& plan = planFor(nonlinear[i], au_in.cur_index, au.cur_index, au_in.exponent,
+                                                 au_in.params, au_in.params_len, storage);
+            applyPlan(plan, converted.data(), converted.size());
+        }
+        values_in = converted.data();
+    }
+
+    const T scale = (T)factor;
+    if ( oper == '*' ) {
+        for(size_t i = 0; i < _size; i++) {
+            _values[i] *= scale*values_in[i*stride];
+        }
+    }
+    else {
+        for(size_t i = 0; i < _size; i++) {
+            _values[i] /= scale*values_in[i*stride];
+        }
+    }
+
+    _units = signature.getUnits();
+
+    return true;
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Array sum in values of the same units by + or -. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+bool BasicUValueArray<T>::sumIn(char oper, const UnitTable& units_in, const T * values_in, size_t stride)
+{
+    // the values are converted class by class
+    if ( !_units.sameClasses(units_in) ) {
+        fillNaN();
+        return false;
+    }
+
+    engine_uv factor = 1.0;
+    std::vector<int> nonlinear;
+
+    for(int unit_class = 0; unit_class < eUnitClassCount; ++unit_class)
+    {
+        if ( !_units.contains(unit_class) ) {
+            continue;
+        }
+
+        const UnitSlot& au_in = units_in[unit_class];
+        ConversionPlan storage;
+        const ConversionPlan& plan = planFor(unit_class, au_in.cur_index, _units[unit_class].cur_index,
+                                             au_in.exponent, au_in.params, au_in.params_len, storage);
+        if ( !foldLinearPlan(plan, factor) ) {
+            nonlinear.push_back(unit_class);
+        }
+    }
+
+    std::vector<T> converted;
+    if ( !nonlinear.empty() ) {
+        converted.assign(values_in, values_in + (stride ? _size : 1));
+        for(size_t i = 0; i < nonlinear.size(); i++)
+        {
+            const UnitSlot& au_in = units_in[nonlinear[i]];
+            ConversionPlan storage;
+            const ConversionPlan& plan = planFor(nonlinear[i], au_in.cur_index,
+                                                 _units[nonlinear[i]].cur_index, au_in.exponent,
+                                                 au_in.params, au_in.params_len, storage);
+            applyPlan(plan, converted.data(), converted.size());
+        }
+        values_in = converted.data();
+    }
+
+    const T scale = (T)factor;
+    if ( oper == '+' ) {
+        for(size_t i = 0; i < _size; i++) {
+            _values[i] += scale*values_in[i*stride];
+        }
+    }
+    else {
+        for(size_t i = 0; i < _size; i++) {
+            _values[i] -= scale*values_in[i*stride];
+        }
+    }
+
+    return true;
+}
+
+template<typename T>
+void BasicUValueArray<T>::fillNaN(void)
+{
+    for(size_t i = 0; i < _size; i++) {
+        _values[i] = NAN;
+    }
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Array element-wise operators. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator*=(const BasicUValueArray<T>& array_in)
+{
+    if ( array_in._size != _size ) {
+        fillNaN();
+    }
+    else {
+        foldIn('*', array_in._units, array_in._values, 1);
+    }
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator/=(const BasicUValueArray<T>& array_in)
+{
+    if ( array_in._size != _size ) {
+        fillNaN();
+    }
+    else {
+        foldIn('/', array_in._units, array_in._values, 1);
+    }
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator+=(const BasicUValueArray<T>& array_in)
+{
+    if ( array_in._size != _size ) {
+        fillNaN();
+    }
+    else {
+        sumIn('+', array_in._units, array_in._values, 1);
+    }
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator-=(const BasicUValueArray<T>& array_in)
+{
+    if ( array_in._size != _size ) {
+        fillNaN();
+    }
+    else {
+        sumIn('-', array_in._units, array_in._values, 1);
+    }
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator*=(const BasicUValue<T>& val)
+{
+    if ( val.numberOfTerms() != 1 ) {
+        fillNaN();
+    }
+    else {
+        const BasicUnitGroup<T>& term = val.getUnits().front();
+        T value = term.getValue();
+        foldIn('*', term.getUnits(), &value, 0);
+    }
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator/=(const BasicUValue<T>& val)
+{
+    if ( val.numberOfTerms() != 1 ) {
+        fillNaN();
+    }
+    else {
+        const BasicUnitGroup<T>& term = val.getUnits().front();
+        T value = term.getValue();
+        foldIn('/', term.getUnits(), &value, 0);
+    }
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator+=(const BasicUValue<T>& val)
+{
+    if ( val.numberOfTerms() != 1 ) {
+        fillNaN();
+    }
+    else {
+        const BasicUnitGroup<T>& term = val.getUnits().front();
+        T value = term.getValue();
+        sumIn('+', term.getUnits(), &value, 0);
+    }
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator-=(const BasicUValue<T>& val)
+{
+    if ( val.numberOfTerms() != 1 ) {
+        fillNaN();
+    }
+    else {
+        const BasicUnitGroup<T>& term = val.getUnits().front();
+        T value = term.getValue();
+        sumIn('-', term.getUnits(), &value, 0);
+    }
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator*=(T val)
+{
+    const ConversionPlan scale = { ePlanScale, val, 0, 1 };
+    applyConversionPlanBulk(scale, _values, _size);
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator/=(T val)
+{
+    for(size_t i = 0; i < _size; i++) {
+        _values[i] /= val;
+    }
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator+=(T val)
+{
+    const ConversionPlan offset = { ePlanAffine, 1, val, 1 };
+    applyConversionPlanBulk(offset, _values, _size);
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T>& BasicUValueArray<T>::operator-=(T val)
+{
+    const ConversionPlan offset = { ePlanAffine, 1, -val, 1 };
+    applyConversionPlanBulk(offset, _values, _size);
+    return *this;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator*(const BasicUValueArray<T>& array_in) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array *= array_in;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator/(const BasicUValueArray<T>& array_in) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array /= array_in;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator+(const BasicUValueArray<T>& array_in) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array += array_in;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator-(const BasicUValueArray<T>& array_in) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array -= array_in;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator*(const BasicUValue<T>& val) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array *= val;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator/(const BasicUValue<T>& val) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array /= val;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator+(const BasicUValue<T>& val) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array += val;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator-(const BasicUValue<T>& val) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array -= val;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator*(T val) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array *= val;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator/(T val) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array /= val;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator+(T val) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array += val;
+    return new_array;
+}
+
+template<typename T>
+BasicUValueArray<T> BasicUValueArray<T>::operator-(T val) const
+{
+    BasicUValueArray<T> new_array(*this);
+    new_array -= val;
+    return new_array;
+}
+
+///-------------------------------------------------------------------------------------------------
+/// <summary>	Unit Value Array printUnits. </summary>
+///
+/// <remarks>	Michael Ryan, 5/11/2012. </remarks>
+///-------------------------------------------------------------------------------------------------
+template<typename T>
+std::string BasicUValueArray<T>::printUnits(void) const
+{
+    typename BasicUValue<T>::UnitGroupList group;
+    group.push_back(BasicUnitGroup<T>(1, 0, _units));
+
+    return BasicUValue<T>(1, group).printUnits();
+}
+
+/*
+ The precisions built into the library
+ */
+template class BasicUValueArray<float>;
+template class BasicUValueArray<double>;
+template class BasicUValueArray<long double>;
@@ -0,0 +1,132 @@
+///-------------------------------------------------------------------------------------------------
+// file:	UValueCounters.cpp
+//
+// summary:  Defines the thread local hot path counters and the hooks that increment them
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include "UValueCounters.h"
+
+static HotPathCounters emptyCounters(void)
+{
+    HotPathCounters counters;
+
+    for(int unit_class = 0; unit_class < eUnitClassCount; unit_class++)
+    {
+        counters.clones[unit_class] = 0;
+        counters.class_allocations[unit_class] = 0;
+        counters.nan_results[unit_class] = 0;
+    }
+    for(int site = 0; site < eAllocSiteCount; site++)
+    {
+        counters.allocations[site] = 0;
+    }
+    counters.vector_values = 0;
+
+    return counters;
+}
+
+#ifdef UV_ENABLE_COUNTERS
+
+static HotPathCounters& threadCounters(void)
+{
+    static thread_local HotPathCounters counters = emptyCounters();
+
+    return counters;
+}
+
+static inline bool isUnitClass(int unit_class)
+{
+    return ( unit_class >= 0 && unit_class < eUnitClassCount );
+}
+
+void countConversion(int unit_class, int in, int out, size_t values, size_t nans)
+{
+    if ( !isUnitClass(unit_class) ) {
+        return;
+    }
+
+    int units_len = unit_classes[unit_class].units_len;
+    if ( in < 0 || out < 0 || in >= units_len || out >= units_len ) {
+        return;
+    }
+
+    HotPathCounters& counters = threadCounters();
+    std::vector<unsigned long long>& conversions = counters.conversions[unit_class];
+    if ( conversions.empty() ) {
+        conversions.resize(units_len*units_len, 0);
+    }
+    conversions[in*units_len + out] += values;
+    counters.nan_results[unit_class] += nans;
+}
+
+void countClone(int unit_class)
+{
+    if ( isUnitClass(unit_class) ) {
+        threadCounters().clones[unit_class]++;
+    }
+}
+
+void countAllocation(AllocationSite site, int unit_class)
+{
+    HotPathCounters& counters = threadCounters();
+
+    counters.allocations[site]++;
+    if ( isUnitClass(unit_class) ) {
+        counters.class_allocations[unit_class]++;
+    }
+}
+
+void countVectorValues(size_t values)
+{
+    threadCounters().vector_values += values;
+}
+
+bool countersEnabled(void)
+{
+    return true;
+}
+
+HotPathCounters countersSnapshot(void)
+{
+    return threadCounters();
+}
+
+void resetCounters(void)
+{
+    threadCounters() = emptyCounters();
+}
+
+#else
+
+bool countersEnabled(void)
+{
+    return false;
+}
+
+HotPathCounters countersSnapshot(void)
+{
+    return emptyCounters();
+}
+
+void resetCounters(void)
+{
+}
+
+#endif // UV_ENABLE_COUNTERS
+
+unsigned long long conversionCount(const HotPathCounters& counters, int unit_class, int in, int out)
+{
+    if ( unit_class < 0 || unit_class >= eUnitClassCount || counters.conversions[unit_class].empty() ) {
+        return 0;
+    }
+
+    int units_len = unit_classes[unit_class].units_len;
+    if ( in < 0 || out < 0 || in >= units_len || out >= units_len ) {
+        return 0;
+    }
+
+    return counters.conversions[unit_class][in*units_len + out];
+}
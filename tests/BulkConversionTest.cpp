@@ -0,0 +1,126 @@
+///-------------------------------------------------------------------------------------------------
+// file:	BulkConversionTest.cpp
+//
+// summary:  Tests that the bulk conversions (SSE2/AVX2 kernels for float and double) give the
+//           values of the scalar plan, for every buffer length up to a few vector widths,
+//           and count the NaN results
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <limits>
+#include <vector>
+#include <math.h>
+#include "Conversions.h"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+// longer than two AVX2 vectors of float, so every tail length is covered
+#define MAX_BULK_COUNT          19
+
+int failed_test(const std::string &test_name, size_t count, size_t index, long double val, long double expected)
+{
+    std::cout << FAILED_COLOR << "Failed " << test_name << " count = " << count << " at [" << index
+              << "] val = " << (double)val << " expected " << (double)expected << NOMINAL_COLOR << std::endl;
+
+    return 1;
+}
+
+template<typename T>
+bool sameResult(T val, T expected)
+{
+    if ( ISNAN(expected) ) {
+        return ISNAN(val);
+    }
+    // a scalar multiply and add may be contracted to one fused instruction
+    return fabsl((long double)val - (long double)expected)
+               <= 4*std::numeric_limits<T>::epsilon()*fabsl((long double)expected);
+}
+
+// values with NaNs in the vector part and the tail of the longer buffers
+template<typename T>
+std::vector<T> sampleValues(size_t count)
+{
+    std::vector<T> values(count);
+    for(size_t i = 0; i < count; i++) {
+        values[i] = (T)(0.5 + 1.25*i);
+    }
+    if ( count > 3 ) {
+        values[3] = (T)NAN;
+    }
+    if ( count > 17 ) {
+        values[17] = (T)NAN;
+    }
+    return values;
+}
+
+template<typename T>
+int checkPlan(const std::string &test_name, const ConversionPlan &plan)
+{
+    for(size_t count = 0; count <= MAX_BULK_COUNT; count++)
+    {
+        std::vector<T> values = sampleValues<T>(count);
+        std::vector<T> expected = values;
+        size_t expected_nans = 0;
+        for(size_t i = 0; i < count; i++) {
+            expected_nans += applyConversionPlan(plan, expected[i]) ? 0 : 1;
+        }
+
+        size_t nans = applyConversionPlanBulk(plan, values.data(), count);
+
+        for(size_t i = 0; i < count; i++) {
+            if ( !sameResult(values[i], expected[i]) ) {
+                return failed_test(test_name, count, i, values[i], expected[i]);
+            }
+        }
+        if ( nans != expected_nans ) {
+            return failed_test(test_name + " NaN Count", count, 0, nans, expected_nans);
+        }
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+template<typename T>
+int checkPlans(const std::string &type_name)
+{
+    const int m = unitIndexInUnits("m", dists, dists_len);
+    const int ft = unitIndexInUnits("ft", dists, dists_len);
+    const int c = unitIndexInUnits("C", temps_units, temps_units_len);
+    const int f = unitIndexInUnits("F", temps_units, temps_units_len);
+    const int mw = unitIndexInUnits("mW", ampls, ampls_len);
+    const int dbm = unitIndexInUnits("dBm", ampls, ampls_len);
+
+    if ( checkPlan<T>(type_name + " Scale", conversionPlan(eUnitDist, m, ft)) ) return 1;
+    if ( checkPlan<T>(type_name + " Affine", conversionPlan(eUnitTemp, c, f)) ) return 1;
+    if ( checkPlan<T>(type_name + " Identity", conversionPlan(eUnitDist, m, m)) ) return 1;
+    if ( checkPlan<T>(type_name + " To Log", conversionPlan(eUnitAmpl, mw, dbm)) ) return 1;
+    if ( checkPlan<T>(type_name + " From Log", conversionPlan(eUnitAmpl, dbm, mw)) ) return 1;
+
+    return 0;
+}
+
+int main()
+{
+    if ( checkPlans<float>("Float") ) return 1;
+    if ( checkPlans<double>("Double") ) return 1;
+    if ( checkPlans<long double>("Long Double") ) return 1;
+
+    // an invalid plan leaves the values and reports every one
+    ConversionPlan invalid = conversionPlan(eUnitDist, -1, 0);
+    double values[5] = { 1, 2, 3, 4, 5 };
+    if ( applyConversionPlanBulk(invalid, values, 5) != 5 || values[4] != 5 ) {
+        std::cout << FAILED_COLOR << "Failed Invalid Plan" << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+    std::cout << SUCCESS_COLOR << "Invalid Plan passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
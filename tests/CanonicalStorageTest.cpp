@@ -0,0 +1,81 @@
+///-------------------------------------------------------------------------------------------------
+// file:	CanonicalStorageTest.cpp
+//
+// summary:  Tests that mixed unit arithmetic runs without conversions when linear values are
+//           held in the default unit of their class.  Build the library and this test with
+//           UV_CANONICAL_STORAGE and UV_ENABLE_COUNTERS defined.
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include "UValue.hpp"
+#include "UValueCounters.h"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, bool passed)
+{
+    if ( !passed ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+static unsigned long long distConversions(void)
+{
+    HotPathCounters counters = countersSnapshot();
+    unsigned long long count = 0;
+
+    for(int in = 0; in < unit_classes[eUnitDist].units_len; in++) {
+        for(int out = 0; out < unit_classes[eUnitDist].units_len; out++) {
+            count += conversionCount(counters, eUnitDist, in, out);
+        }
+    }
+
+    return count;
+}
+
+int main()
+{
+#ifndef UV_CANONICAL_STORAGE
+    std::cout << FAILED_COLOR << "Built without UV_CANONICAL_STORAGE" << NOMINAL_COLOR << std::endl;
+    return 1;
+#endif
+    if ( !countersEnabled() ) {
+        std::cout << FAILED_COLOR << "Library built without UV_ENABLE_COUNTERS" << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    UValue ft(3.0, DistUnit("ft"));
+    UValue m(1.0, DistUnit("m"));
+    UValue km(2.0, DistUnit("km"));
+    UValue mi(1.0, DistUnit("mi"));
+
+    resetCounters();
+    UValue sum = ft + m;
+    UValue area = km*mi;
+    UValue ratio = km/m;
+    if ( check("Arithmetic Without Conversions", distConversions() == 0) ) return 1;
+
+    // the units shown are those of the left operand
+    if ( check("Sum", sum.print() == (ft + UValue(1.0, DistUnit("m"))["ft"]).print()
+               && sum["m"].print() == UValue(1.9144, DistUnit("m")).print()) ) return 1;
+    if ( check("Product", area["m"].print() == UValue(2000.0*1609.344, eUnitDist, 7, 2).print()) ) return 1;
+    if ( check("Ratio", ratio.print() == "2000 ") ) return 1;
+
+    resetCounters();
+    UValue feet = m["ft"];
+    if ( check("Conversion Only Relabels", distConversions() == 0
+               && feet.getValue() == UValue(1.0, DistUnit("m"))["ft"].getValue()) ) return 1;
+
+    return 0;
+}
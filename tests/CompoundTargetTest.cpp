@@ -0,0 +1,98 @@
+///-------------------------------------------------------------------------------------------------
+// file:	CompoundTargetTest.cpp
+//
+// summary:  Tests conversions to units joined by '*' and '/' (i.e. "km/h"), and the errors of
+//           units that are unknown or do not fit the value
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include "UValue.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, bool passed)
+{
+    if ( !passed ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+static bool near(double_uv value, double_uv expected)
+{
+    return std::fabs(value - expected) <= 1e-12*std::fabs(expected);
+}
+
+static bool same(const UValue &val, const UValue &expected)
+{
+    return std::fabs(val.getValue() - expected.getValue()) <= 1e-12*std::fabs(expected.getValue())
+           && val.print() == expected.print();
+}
+
+static UnitTargetError convertError(UValue val, const char * units)
+{
+    UnitTargetError error = eTargetOk;
+    val.convertTo(units, &error);
+    return error;
+}
+
+int main()
+{
+    const int second = unitIndexInClass(eUnitTime, "s");
+    const UValue speed = UValue(10, DistUnit("m"))/UValue(1, TimeUnit("s"));
+    const UValue accel = speed/UValue(1, TimeUnit("s"));
+
+    if ( check("Quotient", same(speed["km/h"], speed["km"]["h"]) && near(speed["km/h"].getValue(), 36)) ) return 1;
+    if ( check("Spaces", same(speed[" km / h "], speed["km/h"])) ) return 1;
+    if ( check("Exponent", same(accel["ft/s^2"], accel["ft"])) ) return 1;
+    if ( check("Product", same((speed*UValue(2, MassUnit("kg")))["g*km/h"], (speed*UValue(2, MassUnit("kg")))["g"]["km"]["h"])) ) return 1;
+
+    // units of other classes with the dimensions of the value
+    UValue joules(7200, new EnergyUnit("J"));
+    if ( check("Product Of Other Classes", same(joules["W*h"], UValue(2, "W*h"))) ) return 1;
+    UValue force = UValue(2, MassUnit("kg"))*accel;
+    if ( check("Abbrev. With Operators", same(force["kg*m/s^2"], UValue(20, new ForceUnit("kg*m/s^2")))) ) return 1;
+
+    // errors leave the value as it is
+    UValue unchanged = speed;
+    UnitTargetError error = eTargetOk;
+    if ( check("Unknown Unit", !unchanged.convertTo("km/hr", &error) && error == eTargetUnknownUnit
+               && same(unchanged, speed) && same(speed["km/hr"], speed)) ) return 1;
+    if ( check("Syntax", convertError(speed, "km//h") == eTargetSyntax
+               && convertError(speed, "km/h^x") == eTargetSyntax
+               && convertError(speed, "km/") == eTargetSyntax) ) return 1;
+    if ( check("Empty", convertError(speed, "") == eTargetEmpty && convertError(speed, nullptr) == eTargetEmpty) ) return 1;
+    if ( check("Repeated Class", convertError(speed, "m*ft/s") == eTargetRepeatedClass) ) return 1;
+    if ( check("Mismatch", convertError(speed, "kg") == eTargetMismatch) ) return 1;
+    UValue meters = UValue(1, "m");
+    if ( check("Units Not Held", convertError(UValue(1, eUnitTime, second, -1), "rad/min") == eTargetMismatch
+               && convertError(meters, "km/h") == eTargetMismatch) ) return 1;
+    if ( check("Exponent Mismatch", convertError(speed, "km*h") == eTargetMismatch
+               && convertError(meters*meters, "km^3") == eTargetMismatch) ) return 1;
+    UValue temp_squared = UValue(1, "C^2");
+    unchanged = temp_squared;
+    if ( check("Affine Exponent", !unchanged.convertTo("F", &error) && error == eTargetMismatch
+               && same(unchanged, temp_squared)) ) return 1;
+    if ( check("Too Many Units", convertError(speed, "m*s*kg*A*K*Hz*N*J*W") == eTargetTooManyUnits) ) return 1;
+
+    // a polynomial converts the terms that can be
+    UValue polynomial = UValue(1, DistUnit("m")) + UValue(1, TimeUnit("s"));
+    if ( check("Polynomial", !polynomial.convertTo("km") && near(polynomial.getValue(0), 0.001)
+               && same(polynomial, UValue(1, DistUnit("m"))["km"] + UValue(1, TimeUnit("s")))) ) return 1;
+
+    // a missing abbrev. is not the first unit
+    if ( check("Missing Abbrev.", DistUnit("m")["kg"] == -1 && DistUnit("m")["fm"] == 0) ) return 1;
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+///-------------------------------------------------------------------------------------------------
+// file:	ConstructionTest.cpp
+//
+// summary:  Tests that Unit Values built from a unit value or a unit index match those
+//           built from a unit pointer, and that they make no heap allocation
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <iostream>
+#include <string>
+#include <new>
+#include "UValue.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+static size_t allocations = 0;
+
+void * operator new(size_t size)
+{
+    allocations++;
+    void * p = malloc(size ? size : 1);
+    if ( !p ) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void * p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+    free(p);
+}
+
+int check(const std::string &test_name, const UValue &val, const UValue &expected)
+{
+    if ( !(val == expected) || val.print() != expected.print() ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << " at val = " << val
+                  << " expected " << expected << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+int main()
+{
+    const UValue expected(5.0, new DistUnit("km"));
+    const UValue expected_power(3.0, new AmplUnit("dBm"));
+
+    size_t before = allocations;
+    UValue by_value(5.0, DistUnit("km"));
+    UValue by_index(5.0, eUnitDist, unitIndexInClass(eUnitDist, "km"));
+    UValue power(3.0, AmplUnit("dBm"));
+    size_t made = allocations - before;
+
+    if ( check("Unit Value Construction", by_value, expected) ) return 1;
+    if ( check("Unit Index Construction", by_index, expected) ) return 1;
+    if ( check("Unit Value Parameters", power["mW"], expected_power["mW"]) ) return 1;
+
+    if ( made != 0 ) {
+        std::cout << FAILED_COLOR << "Failed Construction Allocations count = " << made << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+    std::cout << SUCCESS_COLOR << "Construction Allocations passed " << NOMINAL_COLOR << std::endl;
+
+    UValue bad_index(5.0, eUnitDist, unit_classes[eUnitDist].units_len);
+    if ( bad_index.getValue() == bad_index.getValue() ) {
+        std::cout << FAILED_COLOR << "Failed Bad Unit Index" << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+    std::cout << SUCCESS_COLOR << "Bad Unit Index passed " << NOMINAL_COLOR << std::endl;
+
+    const UnitRecord bad_record = { (short)(eUnitClassCount + 3), 0, 2 };
+    if ( AtomicUnit(bad_record).getUnitClass() != eUnitScalar || AtomicUnit(bad_record).exponent != 1
+         || UValue(5.0, bad_record).getValue() == UValue(5.0, bad_record).getValue() ) {
+        std::cout << FAILED_COLOR << "Failed Bad Unit Record" << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+    std::cout << SUCCESS_COLOR << "Bad Unit Record passed " << NOMINAL_COLOR << std::endl;
+
+    static const char *const custom_units[] = { "a", "b" };
+    UValue custom(5.0, AtomicUnit(custom_units, 2, IdentityConversion, "a"));
+    if ( custom.getValue() == custom.getValue() ) {
+        std::cout << FAILED_COLOR << "Failed Unregistered Units Table" << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+    std::cout << SUCCESS_COLOR << "Unregistered Units Table passed " << NOMINAL_COLOR << std::endl;
+
+    // a unit table holds UNIT_SLOT_PARAMS parameters, so a unit with more is refused
+    AmplUnit long_params("dBm");
+    long_params.setParam(75, UNIT_SLOT_PARAMS);
+    UValue too_many(5.0, long_params);
+    if ( too_many.getValue() == too_many.getValue() ) {
+        std::cout << FAILED_COLOR << "Failed Too Many Parameters" << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+    std::cout << SUCCESS_COLOR << "Too Many Parameters passed " << NOMINAL_COLOR << std::endl;
+
+    const int meter = unitIndexInClass(eUnitDist, "m");
+    UValue product = UValue(2.0, TimeUnit("s"))*UValue(3.0, DistUnit("m"));
+    UValue force(6.0, "kg*m/(s^2)");
+    UValue root(2.0, eUnitDist, meter, 0.5);
+    UValue inverse_root(2.0, eUnitDist, meter, -0.5);
+    if ( product.printUnits() != "ms" || force.printUnits() != "(mkg)/(s^2)"
+         || root.printUnits() != "m^0.5" || inverse_root.printUnits() != "1/(m^0.5)" ) {
+        std::cout << FAILED_COLOR << "Failed Print Units " << product.printUnits() << " " << force.printUnits()
+                  << " " << root.printUnits() << " " << inverse_root.printUnits() << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+    std::cout << SUCCESS_COLOR << "Print Units passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+///-------------------------------------------------------------------------------------------------
+// file:	CountersTest.cpp
+//
+// summary:  Tests the hot path counters.  Build the library and this test with
+//           UV_ENABLE_COUNTERS defined.
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include "UValueArray.hpp"
+#include "UValueCounters.h"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, unsigned long long count, unsigned long long expected)
+{
+    if ( count != expected ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << " count = " << count
+                  << " expected " << expected << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+int main()
+{
+    if ( !countersEnabled() ) {
+        std::cout << FAILED_COLOR << "Library built without UV_ENABLE_COUNTERS" << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    UValue dist(1500.0, new DistUnit("m"));
+    UValue time(2.0, new TimeUnit("min"));
+
+    resetCounters();
+
+    // read, as with UV_CANONICAL_STORAGE the value is only converted when it is read
+    UValue km = dist["km"];
+    km.getValue();
+    HotPathCounters counters = countersSnapshot();
+    int m = unitIndexInClass(eUnitDist, "m");
+    int k = unitIndexInClass(eUnitDist, "km");
+    if ( check("Conversion Count", conversionCount(counters, eUnitDist, m, k), 1) ) return 1;
+    if ( check("Single Term Allocations", counters.allocations[eAllocTerm], 0) ) return 1;
+
+    resetCounters();
+    UValue polynomial = dist + time;
+    counters = countersSnapshot();
+    if ( check("Second Term Allocations", counters.allocations[eAllocTerm], 1) ) return 1;
+
+    // made after the reset, as with UV_CANONICAL_STORAGE min is converted to s when the
+    // value is made and speed["s"] converts nothing
+    resetCounters();
+    UValue speed = dist/UValue(2.0, new TimeUnit("min"));
+    speed = speed["s"];
+    speed.getValue();
+    counters = countersSnapshot();
+    int min = unitIndexInClass(eUnitTime, "min");
+    int s = unitIndexInClass(eUnitTime, "s");
+    if ( check("Compound Conversion Count", conversionCount(counters, eUnitTime, min, s), 1) ) return 1;
+
+    resetCounters();
+    AmplUnit dbm("dBm");
+    AtomicUnit * copy = dbm.clone();
+    delete copy;
+    counters = countersSnapshot();
+    if ( check("Clone Count", counters.clones[eUnitAmpl], 1) ) return 1;
+
+    resetCounters();
+    double_uv values[] = {1.0, -1.0, 4.0};
+    convertBulk(eUnitAmpl, values, 3, unitIndexInClass(eUnitAmpl, "mW"), unitIndexInClass(eUnitAmpl, "dBm"));
+    counters = countersSnapshot();
+    if ( check("Bulk NaN Count", counters.nan_results[eUnitAmpl], 1) ) return 1;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    // columns of double reach the vector kernels through the registry and BasicUValueArray
+    // alike, while long double has none
+    const int ft = unitIndexInClass(eUnitDist, "ft");
+    double samples[64];
+    for(int i = 0; i < 64; i++) {
+        samples[i] = 0.5*i;
+    }
+    resetCounters();
+    bulkConversion<double>(unit_classes[eUnitDist])(samples, 64, m, ft, nullptr, 0);
+    BasicUValueArray<double> column(samples, 64, DistUnit("m"));
+    column = column["ft"];
+    counters = countersSnapshot();
+    if ( check("Vector Kernel Count", counters.vector_values, 128) ) return 1;
+
+    resetCounters();
+    BasicUValueArray<long double> wide(64, DistUnit("m"), 1.0);
+    wide = wide["ft"];
+    counters = countersSnapshot();
+    if ( check("Long Double Vector Count", counters.vector_values, 0) ) return 1;
+#endif
+
+    resetCounters();
+    counters = countersSnapshot();
+    if ( check("Reset", counters.allocations[eAllocTerm] + conversionCount(counters, eUnitDist, m, k), 0) ) return 1;
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+///-------------------------------------------------------------------------------------------------
+// file:	CrossClassTest.cpp
+//
+// summary:  Tests that Unit Values convert to units of other classes with the same dimensions,
+//           i.e. kW*h to W-h, Hz to 1/s and sq m to m^2
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include "UValue.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, const UValue &val, const UValue &expected)
+{
+    if ( std::fabs(val.getValue() - expected.getValue()) > 1e-12*std::fabs(expected.getValue())
+         || val.print() != expected.print() ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << " at val = " << val
+                  << " expected " << expected << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+int main()
+{
+    const int second = unitIndexInClass(eUnitTime, "s");
+    const int meter = unitIndexInClass(eUnitDist, "m");
+
+    UValue energy = UValue(1.5, new PowerUnit("kW"))*UValue(2, TimeUnit("h"));
+    if ( check("Product To Unit", energy["W-h"], UValue(3000, new EnergyUnit("W-h"))) ) return 1;
+
+    UValue watt_hours(1, new EnergyUnit("W-h"));
+    if ( check("Unit To Product", watt_hours["W"],
+               UValue(3600, "W*s")) ) return 1;
+    if ( check("Unit To Product Units", watt_hours["W"]["h"],
+               UValue(1, "W*h")) ) return 1;
+
+    UValue frequency(50, FrequencyUnit("kHz"));
+    if ( check("Hz To 1/s", frequency["s"], UValue(5e4, eUnitTime, second, -1)) ) return 1;
+    if ( check("1/s To Hz", UValue(5e4, eUnitTime, second, -1)["kHz"], frequency) ) return 1;
+
+    UValue area(3, new AreaUnit("sq m"));
+    if ( check("sq m To m^2", area["m"], UValue(3, eUnitDist, meter, 2)) ) return 1;
+    if ( check("cm^2 To sq m", (UValue(20, DistUnit("cm"))*UValue(50, DistUnit("cm")))["sq m"],
+               UValue(0.1, new AreaUnit("sq m"))) ) return 1;
+
+    if ( check("m^3 To ml", UValue(2, eUnitDist, meter, 3)["ml"], UValue(2e6, new VolumeUnit("ml"))) ) return 1;
+    if ( check("cm^3 To ml", UValue(7, new VolumeUnit("cm^3"))["ml"], UValue(7, new VolumeUnit("ml"))) ) return 1;
+
+    UValue force = UValue(2, MassUnit("kg"))*UValue(3, DistUnit("m"))/UValue(1, eUnitTime, second, 2);
+    if ( check("Product To Named Product", force["kg*m/s^2"], UValue(6, new ForceUnit("kg*m/s^2"))) ) return 1;
+
+    // no unit of the dimensions is left as it is
+    UValue dist(4, DistUnit("m"));
+    if ( check("No Route", dist["s"], dist) ) return 1;
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+///-------------------------------------------------------------------------------------------------
+// file:	DimensionTest.cpp
+//
+// summary:  Tests that terms of the same SI dimensions are like terms whatever their unit
+//           classes, so N and kg*m/s^2 are summed into one term
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include "UValue.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, bool passed)
+{
+    if ( !passed ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+static bool near(double_uv value, double_uv expected)
+{
+    return std::fabs(value - expected) <= 1e-12*std::fabs(expected);
+}
+
+int main()
+{
+    const UValue mass(2.0, MassUnit("kg"));
+    const UValue second(1.0, TimeUnit("s"));
+    const UValue accel = UValue(3.0, DistUnit("m"))/(second*second);
+
+    // the units are those of the left operand
+    UValue force = UValue(1, new ForceUnit("N")) + mass*accel;
+    if ( check("Force", force.numberOfTerms() == 1 && near(force.getValue(), 7)
+               && force.print() == UValue(7, new ForceUnit("N")).print()) ) return 1;
+    UValue newtons = mass*accel + UValue(1, new ForceUnit("N"));
+    if ( check("Force In Base Units", newtons.numberOfTerms() == 1 && near(newtons.getValue(), 7)) ) return 1;
+
+    // accumulating a sum keeps one term
+    UValue total(0, new ForceUnit("lbf"));
+    for(int i = 0; i < 50; i++) {
+        total = total + mass*accel;
+    }
+    if ( check("Accumulated Force", total.numberOfTerms() == 1
+               && near(total["N"].getValue(), 300)) ) return 1;
+
+    UValue work = UValue(1, new EnergyUnit("J")) + UValue(1, new ForceUnit("N"))*UValue(2, DistUnit("km"));
+    if ( check("Energy", work.numberOfTerms() == 1 && near(work.getValue(), 2001)) ) return 1;
+
+    UValue volume = UValue(1, new VolumeUnit("l")) + UValue(10, DistUnit("cm")).pow(3);
+    if ( check("Volume", volume.numberOfTerms() == 1 && near(volume.getValue(), 2)) ) return 1;
+
+    UValue area = UValue(3, new AreaUnit("sq m")) - UValue(50, DistUnit("cm"))*UValue(2, DistUnit("m"));
+    if ( check("Area", area.numberOfTerms() == 1 && near(area.getValue(), 2)) ) return 1;
+
+    UValue root = UValue(4, new AreaUnit("sq m")).pow(0.5) + UValue(1, DistUnit("m"));
+    if ( check("Fractional Exponent", root.numberOfTerms() == 1 && near(root.getValue(), 3)) ) return 1;
+
+    // equal values are compared in the same units, not as raw numbers
+    const UValue one_newton(1, new ForceUnit("N"));
+    if ( check("Equal By Dimension", one_newton == UValue(1000, MassUnit("g"))*UValue(1, DistUnit("m"))/(second*second)
+               && !(one_newton == UValue(1, MassUnit("g"))*UValue(1, DistUnit("m"))/(second*second))) ) return 1;
+    if ( check("Equal In Class", UValue(0.3048, DistUnit("m")) == UValue(1, DistUnit("ft"))
+               && UValue(1, DistUnit("m")) != UValue(1, DistUnit("ft"))
+               && UValue(20, TempUnit("C")) == UValue(68, TempUnit("F"))) ) return 1;
+
+    // classes with no dimension stay apart
+    UValue angle = UValue(1, new AngleUnit("rad")) + UValue(1.0);
+    if ( check("Angle Apart", angle.numberOfTerms() == 2) ) return 1;
+    UValue unlike = UValue(1, new ForceUnit("N")) + mass*accel*second;
+    if ( check("Unlike Dimensions", unlike.numberOfTerms() == 2) ) return 1;
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+///-------------------------------------------------------------------------------------------------
+// file:	ExponentTest.cpp
+//
+// summary:  Tests that units raised to an exponent convert by factor^exponent and that
+//           temperatures and power ratios reject exponents other than 1
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include "UValue.hpp"
+#include "UValueArray.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, bool passed)
+{
+    if ( !passed ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+int main()
+{
+    int m = unitIndexInClass(eUnitDist, "m");
+    int ft = unitIndexInClass(eUnitDist, "ft");
+    engine_uv factor = conversionPlan(eUnitDist, m, ft).scale;
+
+    ConversionPlan plan;
+    if ( check("Squared Plan", makeExponentPlan(plan, eUnitDist, m, ft, 2)
+               && plan.scale == factor*factor) ) return 1;
+    if ( check("Inverse Plan", makeExponentPlan(plan, eUnitDist, m, ft, -3)
+               && plan.scale == 1/(factor*factor*factor)) ) return 1;
+
+    UValue area(3.0, eUnitDist, m, 2);
+    if ( check("Squared Conversion", area["ft"].getValue() == (double_uv)3.0*(double_uv)(factor*factor)) ) return 1;
+
+    // m*ft^2 takes the ft^2 into m^3
+    engine_uv inverse = conversionPlan(eUnitDist, ft, m).scale;
+    UValue volume = UValue(1.0, DistUnit("m"))*UValue(1.0, eUnitDist, ft, 2);
+    if ( check("Squared Fold", volume.getValue() == (double_uv)(inverse*inverse)
+               && volume.print() == UValue((double_uv)(inverse*inverse), eUnitDist, m, 3).print()) ) return 1;
+
+    int C = unitIndexInClass(eUnitTemp, "C");
+    int F = unitIndexInClass(eUnitTemp, "F");
+    if ( check("Affine Exponent Rejected", !makeExponentPlan(plan, eUnitTemp, C, F, 2)
+               && plan.kind == ePlanInvalid) ) return 1;
+    if ( check("Log Exponent Rejected", !makeExponentPlan(plan, eUnitAmpl, unitIndexInClass(eUnitAmpl, "dBm"),
+               unitIndexInClass(eUnitAmpl, "mW"), 2)) ) return 1;
+
+    double_uv value = 20;
+    if ( check("Affine Value Unchanged", !convertWithExponentPlan(eUnitTemp, value, C, F, 2)
+               && value == 20) ) return 1;
+
+    UValueArray temps(4, UValue(20.0, eUnitTemp, C, 2));
+    temps.set(0, UValue(1.0, eUnitTemp, F, 2));
+    if ( check("Affine Array NaN", temps.getValue(0) != temps.getValue(0)
+               && temps.getValue(1) == 20) ) return 1;
+
+    return 0;
+}
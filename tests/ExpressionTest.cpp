@@ -0,0 +1,67 @@
+///-------------------------------------------------------------------------------------------------
+// file:	ExpressionTest.cpp
+//
+// summary:  Tests that expressions started with uvExpr give the results of the same
+//           expressions written with the UValue operators
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include "UValueExpr.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, const UValue &val, const UValue &expected)
+{
+    if ( !(val == expected) || val.print() != expected.print() ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << " at val = " << val
+                  << " expected " << expected << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+int main()
+{
+    const UValue mass(2.0, MassUnit("kg"));
+    const UValue dist(3.0, DistUnit("m"));
+    const UValue feet(4.0, DistUnit("ft"));
+    const UValue time(1.5, TimeUnit("s"));
+    const UValue accel = dist/(time*time);
+    const UValue speed(5.0, DistUnit("km"));
+
+    UValue force = uvExpr(mass)*accel;
+    if ( check("Product", force, mass*accel) ) return 1;
+
+    UValue mixed = uvExpr(dist)*feet/(uvExpr(time)*time) + feet*dist/(time*time);
+    if ( check("Fused Expression", mixed, dist*feet/(time*time) + feet*dist/(time*time)) ) return 1;
+
+    UValue scaled = 2.0*uvExpr(dist)/4 - feet;
+    if ( check("Scalars", scaled, 2.0*dist/4 - feet) ) return 1;
+
+    // sums of unlike units and polynomials fall back to the UValue operators
+    UValue polynomial = uvExpr(dist) + time;
+    if ( check("Unlike Sum", polynomial, dist + time) ) return 1;
+
+    UValue polynomial_product = uvExpr(polynomial)*speed;
+    if ( check("Polynomial Operand", polynomial_product, polynomial*speed) ) return 1;
+
+    BasicUValue<float> fmass(2.0f, MassUnit("kg"));
+    BasicUValue<float> faccel(9.8f, DistUnit("m"));
+    BasicUValue<float> fforce = uvExpr(fmass)*faccel*0.5f;
+    if ( !(fforce == fmass*faccel*0.5f) ) {
+        std::cout << FAILED_COLOR << "Failed Float Expression" << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+    std::cout << SUCCESS_COLOR << "Float Expression passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
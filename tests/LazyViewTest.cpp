@@ -0,0 +1,64 @@
+///-------------------------------------------------------------------------------------------------
+// file:	LazyViewTest.cpp
+//
+// summary:  Tests that a view of a Unit Value in other units reads, prints and converts like
+//           operator[], and that a chain of conversions is a single conversion.  Build with
+//           UV_ENABLE_COUNTERS defined to also count the conversions.
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include "UValue.hpp"
+#include "UValueCounters.h"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, bool passed)
+{
+    if ( !passed ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+int main()
+{
+    UValue dist(2.5, DistUnit("m"));
+    UValue time(2.0, TimeUnit("min"));
+    UValue speed = dist/time;
+    UValue polynomial = dist + time;
+
+    if ( check("View Value", dist.as("ft").getValue() == dist["ft"].getValue()) ) return 1;
+    if ( check("View Print", speed.as("ft")["s"].print() == speed["ft"]["s"].print()) ) return 1;
+    if ( check("View Terms", polynomial.as("km").materialize() == polynomial["km"]
+               && polynomial.as("km").getValue(1) == polynomial["km"].getValue(1)) ) return 1;
+
+    // read before the snapshot, as with UV_CANONICAL_STORAGE the conversion is made then
+    resetCounters();
+    UValue feet = dist.as("cm")["in"]["ft"];
+    feet.getValue();
+    HotPathCounters counters = countersSnapshot();
+    if ( check("Chained View", feet.print() == dist["ft"].print()) ) return 1;
+
+    if ( countersEnabled() ) {
+        int m = unitIndexInClass(eUnitDist, "m");
+        int ft = unitIndexInClass(eUnitDist, "ft");
+        int cm = unitIndexInClass(eUnitDist, "cm");
+        if ( check("Chained View Conversions", conversionCount(counters, eUnitDist, m, ft) == 1
+                   && conversionCount(counters, eUnitDist, m, cm) == 0) ) return 1;
+    }
+
+    // back to the units of the source converts nothing
+    if ( check("View Round Trip", dist.as("ft")["m"].getValue() == dist.getValue()) ) return 1;
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+///-------------------------------------------------------------------------------------------------
+// file:	MemoryResourceTest.cpp
+//
+// summary:  Tests that unit clones and the terms of Unit Values are allocated from the
+//           memory resource they are given and nowhere else
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <string.h>
+#include <memory_resource>
+#include <new>
+#include "UValue.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+// monotonic arena that counts what is drawn from it and returned to it
+class CountingResource : public std::pmr::memory_resource
+{
+private:
+    std::pmr::monotonic_buffer_resource arena;
+public:
+    size_t allocations;
+    size_t deallocations;
+
+    CountingResource(void) : allocations(0), deallocations(0) {}
+private:
+    void * do_allocate(size_t bytes, size_t alignment) {
+        allocations++;
+        return arena.allocate(bytes, alignment);
+    }
+    void do_deallocate(void * p, size_t bytes, size_t alignment) {
+        deallocations++;
+        arena.deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+};
+
+int check(const std::string &test_name, bool passed)
+{
+    if ( !passed ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+int main()
+{
+    CountingResource arena;
+
+    AmplUnit dbm("dBm");
+    AtomicUnit * copy = dbm.clone(&arena);
+    if ( check("Clone From Resource", copy->getResource() == &arena && arena.allocations == 1
+               && !strcmp(copy->cur_unit, "dBm")) ) return 1;
+    copy->destroy();
+    if ( check("Destroy Into Resource", arena.deallocations == 1) ) return 1;
+
+    // one term is held inline
+    UValue dist(1500.0, new DistUnit("m"), &arena);
+    UValue time(2.0, new TimeUnit("min"), &arena);
+    if ( check("Single Term", arena.allocations == 1) ) return 1;
+
+    UValue polynomial = dist + time;
+    if ( check("Terms From Resource", polynomial.getResource() == &arena && arena.allocations == 2) ) return 1;
+
+    UValue converted = polynomial["km"];
+    if ( check("Conversion From Resource", converted.getResource() == &arena && arena.allocations == 3) ) return 1;
+
+    // a plain copy leaves the arena
+    UValue heap_copy(polynomial);
+    if ( check("Copy To Heap", heap_copy.getResource() == nullptr && arena.allocations == 3
+               && heap_copy == polynomial) ) return 1;
+
+    UValue moved(std::move(converted));
+    if ( check("Move Keeps Resource", moved.getResource() == &arena && arena.allocations == 3
+               && moved.print() == heap_copy["km"].print()) ) return 1;
+
+    // moving terms into a value that keeps another resource allocates there
+    UValue same_arena(0.0, new DistUnit("m"), &arena);
+    same_arena = std::move(moved);
+    if ( check("Move Assign In Resource", same_arena.getResource() == &arena && arena.allocations == 3
+               && same_arena.print() == heap_copy["km"].print()) ) return 1;
+
+    UValue bounded(0.0, new DistUnit("m"), std::pmr::null_memory_resource());
+    bool thrown = false;
+    try {
+        bounded = UValue(heap_copy);
+    }
+    catch (const std::bad_alloc&) {
+        thrown = true;
+    }
+    if ( check("Move Assign Across Resources", thrown && bounded.getResource() == std::pmr::null_memory_resource()) ) return 1;
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+///-------------------------------------------------------------------------------------------------
+// file:	PolynomialTest.cpp
+//
+// summary:  Tests that sums and comparisons of Unit Values of many terms match like terms
+//           whatever the order of the terms, both below and above the size at which the
+//           terms are indexed
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include "UValue.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, bool passed)
+{
+    if ( !passed ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+// polynomial of unlike terms m^a*s^b, starting at the term at offset, each scaled by scale
+static UValue polynomial(int terms, int offset, double_uv scale)
+{
+    const int meter = unitIndexInClass(eUnitDist, "m");
+    const int second = unitIndexInClass(eUnitTime, "s");
+    UValue poly;
+
+    for(int k = 0; k < terms; k++)
+    {
+        int term = (k + offset) % terms;
+        UValue value = UValue(scale*(1.0 + term), eUnitDist, meter, term % 8 + 1)
+                     * UValue(1.0, eUnitTime, second, term / 8 + 1);
+        poly = ( k == 0 ) ? value : poly + value;
+    }
+
+    return poly;
+}
+
+int testTerms(int terms)
+{
+    const std::string size = " " + std::to_string(terms);
+    UValue poly = polynomial(terms, 0, 1);
+    UValue shifted = polynomial(terms, terms/3, 1);
+
+    if ( check("Unlike Terms" + size, poly.numberOfTerms() == (size_t)terms) ) return 1;
+    if ( check("Equal Out Of Order" + size, poly == shifted && shifted == poly) ) return 1;
+
+    UValue sum = poly + shifted;
+    if ( check("Sum" + size, sum.numberOfTerms() == (size_t)terms
+               && sum == polynomial(terms, 0, 2)) ) return 1;
+
+    UValue difference = polynomial(terms, 1, 3) - poly;
+    if ( check("Difference" + size, difference == polynomial(terms, 0, 2)) ) return 1;
+    if ( check("Not Equal" + size, !(difference == poly) && difference != poly) ) return 1;
+
+    // a term not held is appended
+    UValue extra = poly + UValue(1.0, MassUnit("kg"));
+    if ( check("Appended Term" + size, extra.numberOfTerms() == (size_t)terms + 1
+               && !(extra == poly)) ) return 1;
+
+    // like terms in other units are still like terms
+    UValue feet = poly + UValue(1.0, DistUnit("ft"))*UValue(1.0, eUnitTime,
+                                                           unitIndexInClass(eUnitTime, "s"), 1);
+    if ( check("Like Term In Other Units" + size, feet.numberOfTerms() == (size_t)terms) ) return 1;
+
+    return 0;
+}
+
+int main()
+{
+    // below and above the size of the index
+    if ( testTerms(3) ) return 1;
+    if ( testTerms(80) ) return 1;
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+///-------------------------------------------------------------------------------------------------
+// file:	PowerTest.cpp
+//
+// summary:  Tests that a Unit Value of one term is raised to a power by scaling its exponents
+//           and that whole powers of polynomials expand with like terms combined
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include "UValue.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, bool passed)
+{
+    if ( !passed ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+// coefficient*m^exponent
+static UValue meters(double_uv coefficient, int exponent)
+{
+    return UValue(coefficient, eUnitDist, unitIndexInClass(eUnitDist, "m"), exponent);
+}
+
+int main()
+{
+    UValue dist(3.0, DistUnit("m"));
+    UValue time(2.0, TimeUnit("s"));
+    UValue speed = dist/time;
+
+    UValue squared = speed.pow(2);
+    if ( check("Single Term", squared.numberOfTerms() == 1
+               && squared.print() == (speed*speed).print()) ) return 1;
+
+    UValue binomial = dist + time;
+    if ( check("Binomial Square", binomial.pow(2).numberOfTerms() == 3
+               && binomial.pow(2) == dist*dist + 2.0*dist*time + time*time) ) return 1;
+    if ( check("Binomial Cube", binomial.pow(3) == dist*dist*dist + 3.0*dist*dist*time
+               + 3.0*dist*time*time + time*time*time) ) return 1;
+    if ( check("First Power", binomial.pow(1) == binomial) ) return 1;
+    if ( check("Zero Power", binomial.pow(0) == UValue(1.0)) ) return 1;
+
+    // (m + m^2 + ... + m^10)^2 has the 19 terms m^2 .. m^20
+    UValue series = meters(1, 1);
+    for(int k = 2; k <= 10; k++) {
+        series = series + meters(1, k);
+    }
+    UValue expected = meters(1, 2);
+    for(int k = 3; k <= 20; k++) {
+        expected = expected + meters((k - 1 < 21 - k) ? k - 1 : 21 - k, k);
+    }
+    if ( check("Series Square", series.pow(2).numberOfTerms() == 19
+               && series.pow(2) == expected) ) return 1;
+    if ( check("Series Fourth Power", series.pow(4).numberOfTerms() == 37
+               && series.pow(4) == expected.pow(2)) ) return 1;
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+///-------------------------------------------------------------------------------------------------
+// file:	PrecisionTest.cpp
+//
+// summary:  Tests that BasicUValue<float>, BasicUValue<double> and BasicUValue<long double>
+//           agree with each other to the precision of the value type
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <math.h>
+#include "UValue.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int failed_test(const std::string &test_name, long double val, long double expected)
+{
+    std::cout << FAILED_COLOR << "Failed " << test_name << " at val = " << (double)val
+              << " expected " << (double)expected << NOMINAL_COLOR << std::endl;
+
+    return 1;
+}
+
+// speed of a distance over a time, then converted to ft/min
+template<typename T>
+BasicUValue<T> speed(T dist, T time)
+{
+    BasicUValue<T> d(dist, new DistUnit("km"));
+    BasicUValue<T> t(time, new TimeUnit("h"));
+
+    return (d/t)["ft"]["min"];
+}
+
+template<typename T>
+int check(const std::string &test_name, const BasicUValue<T> &val, const BasicUValue<long double> &expected,
+          long double tolerance)
+{
+    long double v = val.getValue();
+    long double e = expected.getValue();
+
+    if ( fabsl((v - e)/e) > tolerance || val.printUnits() != expected.printUnits() ) {
+        return failed_test(test_name + " (" + val.printUnits() + ")", v, e);
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+int main()
+{
+    BasicUValue<long double> expected = speed<long double>(12.5L, 0.75L);
+
+    if ( check("Float Speed", speed<float>(12.5f, 0.75f), expected, 1e-6) ) return 1;
+    if ( check("Double Speed", speed<double>(12.5, 0.75), expected, 1e-14) ) return 1;
+
+    BasicUValue<float> narrowed(expected);
+    if ( check("Narrowed Speed", narrowed, expected, 1e-6) ) return 1;
+
+    BasicUValue<double> temp(20.0, new TempUnit("C"));
+    BasicUValue<long double> temp_expected(20.0L, new TempUnit("C"));
+    if ( check("Double Temperature", temp["F"], temp_expected["F"], 1e-14) ) return 1;
+
+    BasicUValue<float> power(3.0f, new AmplUnit("dBm"));
+    BasicUValue<long double> power_expected(3.0L, new AmplUnit("dBm"));
+    if ( check("Float Power", power["mW"], power_expected["mW"], 1e-6) ) return 1;
+
+    const size_t count = 19;
+    float meters[count];
+    for(size_t i = 0; i < count; i++) {
+        meters[i] = 0.5f*i - 2.0f;
+    }
+    convertBulk(eUnitDist, meters, count, unitIndexInClass(eUnitDist, "m"), unitIndexInClass(eUnitDist, "ft"));
+    for(size_t i = 0; i < count; i++) {
+        BasicUValue<float> expected_ft = BasicUValue<float>(0.5f*i - 2.0f, new DistUnit("m"))["ft"];
+        if ( fabsf(meters[i] - expected_ft.getValue()) > 1e-5f ) {
+            return failed_test("Float Bulk Conversion", meters[i], expected_ft.getValue());
+        }
+    }
+    std::cout << SUCCESS_COLOR << "Float Bulk Conversion passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+///-------------------------------------------------------------------------------------------------
+// file:	ReduceTest.cpp
+//
+// summary:  Tests that Unit Groups of several units reduce to the derived unit of their
+//           dimensions.  Build with UV_AUTO_REDUCE defined to also test that products are
+//           reduced as they are formed.
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include "UValue.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, bool passed)
+{
+    if ( !passed ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+static bool near(double_uv value, double_uv expected)
+{
+    return std::fabs(value - expected) <= 1e-12*std::fabs(expected);
+}
+
+// reduces to kilo units where the class has them
+class KiloReducer : public Reducer
+{
+public:
+    KiloReducer(UnitGroup &ug) : Reducer(ug) {}
+
+    bool derivedUnit(long long dimension_key, int& unit_class, int& unit_index) const {
+        unit_class = unitClassOfDimension(dimension_key);
+        unit_index = ( unit_class >= 0 ) ? unitIndexInClass(unit_class, "kW") : -1;
+        return ( unit_index >= 0 );
+    }
+};
+
+int main()
+{
+    const UValue grams(1000.0, MassUnit("g"));
+    const UValue meters(1.0, DistUnit("m"));
+    const UValue second(1.0, TimeUnit("s"));
+
+    UValue force = (grams*meters/(second*second)).reduce();
+    if ( check("Force", force.getUnits().front().getUnits().size() == 1
+               && near(force.getValue(), 1)
+               && force.print() == UValue(1, new ForceUnit("N")).print()) ) return 1;
+
+    UValue pounds = (grams*meters/(second*second)).reduce("lbf");
+    if ( check("Named Unit", near(pounds.getValue(), force["lbf"].getValue())) ) return 1;
+
+    UValue power = (UValue(3, new ForceUnit("N"))*UValue(2, DistUnit("km"))/UValue(1, TimeUnit("min"))).reduce();
+    if ( check("Power", near(power.getValue(), 100)
+               && power.print() == UValue(100, new PowerUnit("W")).print()) ) return 1;
+
+    UValue area = (meters*UValue(50, DistUnit("cm"))).reduce();
+    if ( check("Area", near(area.getValue(), 0.5) && area.print() == UValue(0.5, new AreaUnit("sq m")).print()) ) return 1;
+
+    // nothing to reduce
+    UValue km(5, DistUnit("km"));
+    if ( check("Single Unit Kept", km.reduce().print() == km.print()) ) return 1;
+    if ( check("Single Unit Named", near(km.reduce("m").getValue(), 5000)) ) return 1;
+    UValue squared = second*second;
+    if ( check("No Derived Unit", squared.reduce().print() == squared.print()) ) return 1;
+
+    UnitGroup group = (UValue(3, new ForceUnit("N"))*UValue(1, DistUnit("km"))/second).getUnits().front();
+    KiloReducer kilo(group);
+    if ( check("Reducer Rule", near(kilo.reduce().getValue(), 3)
+               && group.getUnits().contains(eUnitPower)) ) return 1;
+
+#ifdef UV_AUTO_REDUCE
+    UValue product = grams*meters/(second*second);
+    if ( check("Auto Reduce", product.getUnits().front().getUnits().size() == 1
+               && near(product["N"].getValue(), 1)) ) return 1;
+#endif
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+///-------------------------------------------------------------------------------------------------
+// file:	UValueArrayTest.cpp
+//
+// summary:  Tests that UValueArray columns match the same operations on single UValues
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <math.h>
+#include <limits>
+#include <stdint.h>
+#include "UValueArray.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int failed_test(const std::string &test_name, size_t index, double_uv val, double_uv expected)
+{
+    std::cout << FAILED_COLOR << "Failed " << test_name << " at index " << index
+              << " at val = " << val << " expected " << expected << NOMINAL_COLOR << std::endl;
+
+    return 1;
+}
+
+bool close_to(double_uv val, double_uv expected)
+{
+    return val == expected || fabs((val - expected)/expected) < 1e-12;
+}
+
+// every element of the column against the same operation on a UValue
+int check_column(const std::string &test_name, const UValueArray &column, const UValue* expected)
+{
+    for(size_t i = 0; i < column.size(); i++)
+    {
+        UValue element = column.at(i);
+        if ( !close_to(element.getValue(), expected[i].getValue())
+            || element.printUnits() != expected[i].printUnits() ) {
+            return failed_test(test_name + " (" + element.printUnits() + ")", i,
+                               element.getValue(), expected[i].getValue());
+        }
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+// columns of another precision than UValueArray in the same program
+template<typename T>
+int check_precision(const std::string &test_name)
+{
+    const size_t count = 19;
+    BasicUValueArray<T> dist(count, DistUnit("m"));
+    BasicUValueArray<T> time(count, TimeUnit("s"));
+    for(size_t i = 0; i < count; i++)
+    {
+        dist.setValue(i, (T)(0.5*i - 2.0));
+        time.setValue(i, (T)(1.0 + i));
+    }
+
+    BasicUValueArray<T> speed = dist["ft"]/time;
+    for(size_t i = 0; i < count; i++)
+    {
+        BasicUValue<T> expected = BasicUValue<T>(dist.getValue(i), DistUnit("m"))["ft"]
+                                  /BasicUValue<T>(time.getValue(i), TimeUnit("s"));
+        BasicUValue<T> element = speed.at(i);
+        T tolerance = 8*std::numeric_limits<T>::epsilon()*std::fabs(expected.getValue());
+        if ( std::fabs(element.getValue() - expected.getValue()) > tolerance
+             || element.printUnits() != expected.printUnits() ) {
+            return failed_test(test_name, i, element.getValue(), expected.getValue());
+        }
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+int main()
+{
+    const size_t count = 37;
+    double_uv meters[count];
+    double_uv seconds[count];
+    UValue expected[count];
+
+    for(size_t i = 0; i < count; i++)
+    {
+        meters[i] = 0.25*i - 3.0;
+        seconds[i] = 1.0 + i;
+    }
+
+    UValueArray dist(meters, count, DistUnit("m"));
+    UValueArray time(seconds, count, TimeUnit("s"));
+
+    if ( ((uintptr_t)dist.data() % UVALUE_ARRAY_ALIGNMENT) != 0 ) {
+        return failed_test("Alignment", 0, 0, 0);
+    }
+
+    UValueArray feet = dist["ft"];
+    for(size_t i = 0; i < count; i++) {
+        expected[i] = UValue(meters[i], new DistUnit("m"))["ft"];
+    }
+    if ( check_column("Column Conversion", feet, expected) ) return 1;
+
+    UValueArray speed = feet/time;
+    for(size_t i = 0; i < count; i++) {
+        expected[i] = UValue(meters[i], new DistUnit("m"))["ft"]/UValue(seconds[i], new TimeUnit("s"));
+    }
+    if ( check_column("Array Division", speed, expected) ) return 1;
+
+    UValueArray sum = dist + feet;
+    for(size_t i = 0; i < count; i++) {
+        expected[i] = UValue(2*meters[i], new DistUnit("m"));
+    }
+    if ( check_column("Array Sum", sum, expected) ) return 1;
+
+    UValue offset(2.0, new DistUnit("km"));
+    UValueArray shifted = dist - offset;
+    for(size_t i = 0; i < count; i++) {
+        expected[i] = UValue(meters[i] - 2000.0, new DistUnit("m"));
+    }
+    if ( check_column("UValue Difference", shifted, expected) ) return 1;
+
+    UValueArray scaled = (dist*3.0)["km"];
+    for(size_t i = 0; i < count; i++) {
+        expected[i] = UValue(3.0*meters[i], new DistUnit("m"))["km"];
+    }
+    if ( check_column("Scalar Product", scaled, expected) ) return 1;
+
+    UValueArray temps(seconds, count, TempUnit("C"));
+    UValueArray fahrenheit = temps["F"];
+    for(size_t i = 0; i < count; i++) {
+        expected[i] = UValue(seconds[i], new TempUnit("C"))["F"];
+    }
+    if ( check_column("Affine Conversion", fahrenheit, expected) ) return 1;
+
+    // values of another impedance are converted with their own in products and sums alike
+    AmplUnit volts("dBmV");
+    volts.setImpedance(75);
+    UValueArray powers(seconds, count, AmplUnit("dBm"));
+    UValueArray levels(seconds, count, volts);
+    UValueArray product = powers*levels;
+    for(size_t i = 0; i < count; i++) {
+        expected[i] = UValue(seconds[i], AmplUnit("dBm"))*UValue(seconds[i], volts);
+    }
+    if ( check_column("Array Product Parameters", product, expected) ) return 1;
+
+    UValueArray total = powers + levels;
+    for(size_t i = 0; i < count; i++) {
+        expected[i] = UValue(seconds[i], AmplUnit("dBm")) + UValue(seconds[i], volts);
+    }
+    if ( check_column("Array Sum Parameters", total, expected) ) return 1;
+
+    UValueArray mismatched = dist + time;
+    for(size_t i = 0; i < count; i++) {
+        if ( !isnan(mismatched.getValue(i)) ) {
+            return failed_test("Mismatched Sum", i, mismatched.getValue(i), NAN);
+        }
+    }
+    std::cout << SUCCESS_COLOR << "Mismatched Sum passed " << NOMINAL_COLOR << std::endl;
+
+    if ( check_precision<float>("Float Column") ) return 1;
+    if ( check_precision<double>("Double Column") ) return 1;
+
+    return 0;
+}
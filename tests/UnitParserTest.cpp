@@ -0,0 +1,135 @@
+///-------------------------------------------------------------------------------------------------
+// file:	UnitParserTest.cpp
+//
+// summary:  Tests that unit expressions parse into the units of the same Unit Values built
+//           from AtomicUnits, abbrevs. with spaces and operators in them included, and that
+//           the parse cache gives the same results from several threads
+//
+//
+//  Copyright (c) 2014 by Michael Ryan
+///-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cmath>
+#include "UValue.hpp"
+
+#define SUCCESS_COLOR           "\033[1;32m"
+#define FAILED_COLOR            "\033[1;31m"
+#define NOMINAL_COLOR           "\033[0m"
+
+int check(const std::string &test_name, const UValue &val, const UValue &expected)
+{
+    if ( !(val == expected) || val.print() != expected.print() ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << " at val = " << val
+                  << " expected " << expected << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+int check(const std::string &test_name, bool passed)
+{
+    if ( !passed ) {
+        std::cout << FAILED_COLOR << "Failed " << test_name << NOMINAL_COLOR << std::endl;
+        return 1;
+    }
+
+    std::cout << SUCCESS_COLOR << test_name << " passed " << NOMINAL_COLOR << std::endl;
+
+    return 0;
+}
+
+static UnitTargetError parseError(const char * units)
+{
+    UnitTable table;
+    return table.parse(units);
+}
+
+const char *const expressions[] = {"kg*m/s^2", "m/s^2", "1/64 in/s", "Imp fl oz/min", "(sq ft)^2",
+                                   "lbf/in^2", "kg/(m*s^2)", "dBm", "km/h", "furlongs/fortnight"};
+const int expressions_len = sizeof(expressions)/sizeof(char *);
+
+int main()
+{
+    const UValue second(1, TimeUnit("s"));
+    const int second_index = unitIndexInClass(eUnitTime, "s");
+
+    // abbrevs. with operators or spaces in them are one unit
+    if ( check("Abbrev. With Operators", UValue(2, "kg*m/s^2"), UValue(2, new ForceUnit("kg*m/s^2"))) ) return 1;
+    if ( check("Pressure Abbrev.", UValue(2, "lbf/in^2"), UValue(2, new PressureUnit("lbf/in^2"))) ) return 1;
+    if ( check("Abbrev. With Spaces", UValue(2, "Imp fl oz/min"),
+               UValue(2, new VolumeUnit("Imp fl oz"))/UValue(1, TimeUnit("min"))) ) return 1;
+    if ( check("Fraction Abbrev.", UValue(3, "1/64 in^2"), UValue(3, eUnitDist, unitIndexInClass(eUnitDist, "1/64 in"), 2)) ) return 1;
+    if ( check("Longest Abbrev.", UValue(2, "kg*m/s^2*s"), UValue(2, new ForceUnit("kg*m/s^2"))*second) ) return 1;
+
+    // products, quotients, powers and groups
+    if ( check("Quotient", UValue(9.8, "m/s^2"), UValue(9.8, DistUnit("m"))/(second*second)) ) return 1;
+    if ( check("Group", UValue(1, "kg/(m*s^2)"), UValue(1, "kg/m/s^2")) ) return 1;
+    if ( check("Group Power", UValue(4, "(sq ft)^2"), UValue(4, eUnitArea, unitIndexInClass(eUnitArea, "sq ft"), 2)) ) return 1;
+    if ( check("Spaces", UValue(1, " km / h "), UValue(1, DistUnit("km"))/UValue(1, TimeUnit("h"))) ) return 1;
+    if ( check("Log Unit", UValue(-30, "dBm"), UValue(-30, AmplUnit("dBm"))) ) return 1;
+    if ( check("Units Cancel", UValue(5, "m/m").print() == UValue(5).print()) ) return 1;
+    if ( check("Empty Numerator", UValue(2, "1/s"), UValue(2, eUnitTime, second_index, -1)) ) return 1;
+    if ( check("Empty Numerator Power", UValue(2, "1 / s^2"), UValue(2, eUnitTime, second_index, -2)) ) return 1;
+    if ( check("Empty Numerator Group", UValue(2, "1/(s)"), UValue(2, "1/s")) ) return 1;
+    if ( check("Empty Numerator In Group", UValue(2, "m*(1/s)"), UValue(2, "m/s")) ) return 1;
+
+    // the units print as they parse
+    const UValue printed[] = {UValue(2, eUnitTime, second_index, -1), UValue(2, eUnitTime, second_index, -0.5),
+                              UValue(9.8, "m/s^2"), UValue(4, "(sq ft)^2"), UValue(1, "1/(sq ft)"), UValue(-30, "dBm")};
+    for(const UValue& val : printed) {
+        if ( check("Print Parse " + val.printUnits(), UValue(val.getValue(), val.printUnits()), val) ) return 1;
+    }
+
+    // errors give NaN
+    if ( check("Unknown Unit", parseError("furlongs/fortnight") == eTargetUnknownUnit
+               && std::isnan(UValue(1, "furlongs/fortnight").getValue())) ) return 1;
+    if ( check("Syntax", parseError("kg/(m*s^2") == eTargetSyntax && parseError("m)") == eTargetSyntax
+               && parseError("m^") == eTargetSyntax && parseError("m**s") == eTargetSyntax
+               && parseError("()") == eTargetSyntax && parseError("1") == eTargetUnknownUnit
+               && parseError("1*s") == eTargetUnknownUnit) ) return 1;
+    if ( check("Empty", parseError(" ") == eTargetEmpty) ) return 1;
+
+    // a string seen before is the same cached result
+    const UnitTarget * first = nullptr;
+    const UnitTarget * again = nullptr;
+    UnitTarget scratch;
+    cachedUnitTarget("kg/(m*s^2)", first, scratch);
+    cachedUnitTarget(std::string("kg/(m*s^2)"), again, scratch);
+    if ( check("Cached", first == again && first != &scratch) ) return 1;
+
+    // the same results from several threads at once
+    std::vector<UValue> expected;
+    for(int i = 0; i < expressions_len; i++) {
+        expected.push_back(UValue(1, std::string(expressions[i]) + " "));
+    }
+    std::vector<int> mismatches(4, 0);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < (int)mismatches.size(); t++) {
+        threads.push_back(std::thread([&, t]() {
+            for(int n = 0; n < 200; n++) {
+                int i = (n + t) % expressions_len;
+                UValue parsed(1, expressions[i]);
+                if ( parsed.print() != expected[i].print() ) {
+                    mismatches[t]++;
+                }
+            }
+        }));
+    }
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+    int total = 0;
+    for(int count : mismatches) {
+        total += count;
+    }
+    if ( check("Threads", total == 0) ) return 1;
+
+    return 0;
+}